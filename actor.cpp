@@ -0,0 +1,172 @@
+#include "actor.hpp"
+#include "highResClock.hpp"
+#include <bit>
+#include <chrono>
+
+namespace ThreadX
+{
+ActorBase::ActorBase(ActorScheduler &scheduler, const Uint priority) : m_scheduler{scheduler}, m_priority{priority}
+{
+    assert(priority < ActorScheduler::priorities);
+}
+
+ActorBase::~ActorBase()
+{
+    assert(m_state == State::idle);
+}
+
+Uint ActorBase::priority() const
+{
+    return m_priority;
+}
+
+ActorMetrics ActorBase::metrics() const
+{
+    Kernel::CriticalSection cs;
+    return m_metrics;
+}
+
+void ActorBase::resetMetrics()
+{
+    Kernel::CriticalSection cs;
+    const auto depth{m_metrics.depth};
+    m_metrics = ActorMetrics{};
+    m_metrics.depth = m_metrics.maxDepth = depth;
+}
+
+bool ActorBase::schedule()
+{
+    if (m_state != State::idle)
+    {
+        return false;
+    }
+
+    m_scheduler.push(*this);
+    return true;
+}
+
+void ActorBase::signalScheduler()
+{
+    [[maybe_unused]] auto error{m_scheduler.m_readySemaphore.release()};
+    assert(error == Error::success);
+}
+
+void ActorBase::unschedule()
+{
+    Kernel::CriticalSection cs;
+    assert(m_state != State::running);
+    if (m_state == State::ready)
+    {
+        m_scheduler.remove(*this);
+    }
+}
+
+ActorScheduler::ActorScheduler(const std::string_view name) : m_readySemaphore{name}
+{
+}
+
+void ActorScheduler::run()
+{
+    while (true)
+    {
+        [[maybe_unused]] auto error{m_readySemaphore.acquire()};
+        assert(error == Error::success);
+
+        ActorBase *actorPtr{};
+        {
+            Kernel::CriticalSection cs;
+            actorPtr = pop();
+        }
+
+        // an actor removed by its destructor leaves its token behind.
+        if (not actorPtr)
+        {
+            continue;
+        }
+
+        const auto start{HighResClock::now()};
+        actorPtr->dispatch();
+        const auto elapsed{Ulong(std::chrono::duration_cast<std::chrono::microseconds>(HighResClock::now() - start).count())};
+
+        bool signal{};
+        {
+            Kernel::CriticalSection cs;
+            auto &metrics{actorPtr->m_metrics};
+            ++metrics.messages;
+            metrics.maxProcessingTime = std::max(metrics.maxProcessingTime, elapsed);
+            metrics.totalProcessingTime += elapsed;
+
+            // the actor goes to the back of its ready list, so actors of the same priority take turns message by message.
+            actorPtr->m_state = ActorBase::State::idle;
+            if (metrics.depth > 0)
+            {
+                signal = actorPtr->schedule();
+            }
+        }
+
+        if (signal)
+        {
+            actorPtr->signalScheduler();
+        }
+    }
+}
+
+void ActorScheduler::push(ActorBase &actor)
+{
+    const auto priority{actor.m_priority};
+    actor.m_state = ActorBase::State::ready;
+    actor.m_next = nullptr;
+    if (m_readyTails[priority])
+    {
+        m_readyTails[priority]->m_next = std::addressof(actor);
+    }
+    else
+    {
+        m_readyHeads[priority] = std::addressof(actor);
+        m_readyBitmap |= Ulong{1} << priority;
+    }
+
+    m_readyTails[priority] = std::addressof(actor);
+}
+
+ActorBase *ActorScheduler::pop()
+{
+    if (m_readyBitmap == 0)
+    {
+        return nullptr;
+    }
+
+    const auto priority{Uint(std::countr_zero(m_readyBitmap))};
+    auto actorPtr{m_readyHeads[priority]};
+    if (m_readyHeads[priority] = actorPtr->m_next; not m_readyHeads[priority])
+    {
+        m_readyTails[priority] = nullptr;
+        m_readyBitmap &= ~(Ulong{1} << priority);
+    }
+
+    actorPtr->m_state = ActorBase::State::running;
+    return actorPtr;
+}
+
+void ActorScheduler::remove(ActorBase &actor)
+{
+    const auto priority{actor.m_priority};
+    ActorBase *previousPtr{};
+    for (auto actorPtr{m_readyHeads[priority]}; actorPtr; previousPtr = std::exchange(actorPtr, actorPtr->m_next))
+    {
+        if (actorPtr == std::addressof(actor))
+        {
+            (previousPtr ? previousPtr->m_next : m_readyHeads[priority]) = actor.m_next;
+            m_readyTails[priority] = m_readyTails[priority] == actorPtr ? previousPtr : m_readyTails[priority];
+            break;
+        }
+    }
+
+    if (not m_readyHeads[priority])
+    {
+        m_readyBitmap &= ~(Ulong{1} << priority);
+    }
+
+    actor.m_state = ActorBase::State::idle;
+}
+} // namespace ThreadX
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "kernel.hpp"
+#include "memoryPool.hpp"
+#include "semaphore.hpp"
+#include "thread.hpp"
+#include "txCommon.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ThreadX
+{
+class ActorScheduler;
+
+/// Mailbox and processing statistics of an actor. Times are in microseconds of HighResClock.
+struct ActorMetrics
+{
+    Ulong depth;    ///< messages in the mailbox
+    Ulong maxDepth; ///< highest depth seen by post()
+    Ulong messages; ///< messages processed
+    Ulong rejected; ///< messages that found the mailbox full
+    Ulong maxProcessingTime;
+    Ulong64 totalProcessingTime;
+};
+
+/// Part of Actor that does not depend on the message type, as seen by the scheduler.
+class ActorBase
+{
+  public:
+    ActorBase(const ActorBase &) = delete;
+    ActorBase &operator=(const ActorBase &) = delete;
+
+    Uint priority() const;
+
+    /// Returns a copy of the metrics, consistent with respect to posting and processing.
+    ActorMetrics metrics() const;
+
+    void resetMetrics();
+
+  protected:
+    /// \param priority dispatch priority, zero is the highest
+    ActorBase(ActorScheduler &scheduler, const Uint priority);
+    ~ActorBase();
+
+    /// makes the actor ready to run, unless it is ready or running already. Must be called in a critical section.
+    /// \return true if the scheduler must be signalled after the critical section
+    bool schedule();
+
+    void signalScheduler();
+
+    /// takes the actor off its ready list. It must not be running.
+    void unschedule();
+
+    ActorMetrics m_metrics{};
+
+  private:
+    friend class ActorScheduler;
+
+    enum class State
+    {
+        idle,
+        ready,
+        running
+    };
+
+    /// processes one message from the mailbox.
+    virtual void dispatch() = 0;
+
+    ActorScheduler &m_scheduler;
+    const Uint m_priority;
+    State m_state{State::idle};
+    ActorBase *m_next{};
+};
+
+/// Ready lists of actors, one per priority, served by the threads that call run().
+/// An actor is run by one thread at a time, one message per turn, so actors of the same priority take turns.
+class ActorScheduler
+{
+  public:
+    static constexpr Uint priorities{wordSize * CHAR_BIT};
+
+    explicit ActorScheduler(const std::string_view name = "actorScheduler");
+
+    ActorScheduler(const ActorScheduler &) = delete;
+    ActorScheduler &operator=(const ActorScheduler &) = delete;
+
+    /// dispatches messages to ready actors, highest priority first. It never returns.
+    [[noreturn]] void run();
+
+  private:
+    friend class ActorBase;
+
+    void push(ActorBase &actor);
+    ActorBase *pop();
+    void remove(ActorBase &actor);
+
+    std::array<ActorBase *, priorities> m_readyHeads{};
+    std::array<ActorBase *, priorities> m_readyTails{};
+    Ulong m_readyBitmap{}; // bit n is set if priority n has a ready actor
+    CountingSemaphore<> m_readySemaphore;
+};
+
+/// ActorScheduler with its own worker threads.
+/// \tparam Pool pool for the worker stacks
+/// \tparam Workers number of worker threads
+template <class Pool, size_t Workers = 4> class ActorRuntime : public ActorScheduler
+{
+  public:
+    explicit ActorRuntime(const std::string_view name, Pool &pool, const Ulong stackSize, const Uint priority = defaultPriority)
+        requires(std::is_base_of_v<BytePoolBase, Pool>);
+
+    explicit ActorRuntime(const std::string_view name, Pool &pool, const Uint priority = defaultPriority)
+        requires(std::is_base_of_v<BlockPoolBase, Pool>);
+
+  private:
+    class Worker : public Thread<Pool>
+    {
+      public:
+        template <typename... Args> explicit Worker(ActorScheduler &scheduler, Args &&...args);
+
+      private:
+        void entryCallback() final;
+
+        ActorScheduler &m_scheduler;
+    };
+
+    std::array<std::optional<Worker>, Workers> m_workers;
+};
+
+/// State machine or other object that receives messages through a mailbox and processes them one at a time on a
+/// worker thread of its scheduler, rather than on a thread of its own.
+/// \tparam Msg message type, copied into the mailbox
+/// \tparam Pool pool the mailbox is allocated from
+template <typename Msg, class Pool> class Actor : public ActorBase
+{
+    static_assert(std::is_nothrow_copy_constructible_v<Msg>);
+
+  public:
+    /// \param capacity number of messages the mailbox holds
+    explicit Actor(ActorScheduler &scheduler, Pool &pool, const Ulong capacity, const Uint priority = 0)
+        requires(std::is_base_of_v<BytePoolBase, Pool>);
+
+    /// the mailbox takes one block.
+    explicit Actor(ActorScheduler &scheduler, Pool &pool, const Uint priority = 0)
+        requires(std::is_base_of_v<BlockPoolBase, Pool>);
+
+    /// copies the message into the mailbox. May be called from ISRs.
+    /// \return Error::queueFull if the mailbox is full
+    Error post(const Msg &message);
+
+  protected:
+    ~Actor();
+
+  private:
+    void dispatch() final;
+
+    /// processes a message. It runs to completion before the next message of this actor is processed.
+    virtual void messageCallback(const Msg &message) = 0;
+
+    Allocation<Pool> m_mailboxAlloc;
+    Msg *const m_mailbox;
+    const Ulong m_capacity;
+    Ulong m_head{};
+};
+
+template <class Pool, size_t Workers>
+ActorRuntime<Pool, Workers>::ActorRuntime(const std::string_view name, Pool &pool, const Ulong stackSize, const Uint priority)
+    requires(std::is_base_of_v<BytePoolBase, Pool>)
+    : ActorScheduler{name}
+{
+    for (auto &worker : m_workers)
+    {
+        worker.emplace(*this, name, pool, stackSize, typename Thread<Pool>::NotifyCallback{}, priority, priority, noTimeSlice, ThreadStartType::dontStart);
+    }
+}
+
+template <class Pool, size_t Workers>
+ActorRuntime<Pool, Workers>::ActorRuntime(const std::string_view name, Pool &pool, const Uint priority)
+    requires(std::is_base_of_v<BlockPoolBase, Pool>)
+    : ActorScheduler{name}
+{
+    for (auto &worker : m_workers)
+    {
+        worker.emplace(*this, name, pool, typename Thread<Pool>::NotifyCallback{}, priority, priority, noTimeSlice, ThreadStartType::dontStart);
+    }
+}
+
+template <class Pool, size_t Workers>
+template <typename... Args>
+ActorRuntime<Pool, Workers>::Worker::Worker(ActorScheduler &scheduler, Args &&...args) : Thread<Pool>{std::forward<Args>(args)...}, m_scheduler{scheduler}
+{
+    // the thread is created suspended so that it cannot run before m_scheduler is set.
+    [[maybe_unused]] auto error{this->resume()};
+    assert(error == Error::success);
+}
+
+template <class Pool, size_t Workers> void ActorRuntime<Pool, Workers>::Worker::entryCallback()
+{
+    m_scheduler.run();
+}
+
+template <typename Msg, class Pool>
+Actor<Msg, Pool>::Actor(ActorScheduler &scheduler, Pool &pool, const Ulong capacity, const Uint priority)
+    requires(std::is_base_of_v<BytePoolBase, Pool>)
+    : ActorBase{scheduler, priority}, m_mailboxAlloc{pool, capacity * sizeof(Msg)}, m_mailbox{reinterpret_cast<Msg *>(m_mailboxAlloc.get())}, m_capacity{capacity}
+{
+    assert(capacity > 0);
+}
+
+template <typename Msg, class Pool>
+Actor<Msg, Pool>::Actor(ActorScheduler &scheduler, Pool &pool, const Uint priority)
+    requires(std::is_base_of_v<BlockPoolBase, Pool>)
+    : ActorBase{scheduler, priority}, m_mailboxAlloc{pool}, m_mailbox{reinterpret_cast<Msg *>(m_mailboxAlloc.get())}, m_capacity{pool.blockSize() / sizeof(Msg)}
+{
+    assert(m_capacity > 0);
+}
+
+template <typename Msg, class Pool> Actor<Msg, Pool>::~Actor()
+{
+    // dispatch() is not callable any more once this destructor has started.
+    unschedule();
+    for (; m_metrics.depth > 0; --m_metrics.depth)
+    {
+        std::destroy_at(m_mailbox + m_head);
+        m_head = (m_head + 1) % m_capacity;
+    }
+}
+
+template <typename Msg, class Pool> Error Actor<Msg, Pool>::post(const Msg &message)
+{
+    bool signal{};
+    {
+        Kernel::CriticalSection cs;
+        if (m_metrics.depth == m_capacity)
+        {
+            ++m_metrics.rejected;
+            return Error::queueFull;
+        }
+
+        std::construct_at(m_mailbox + (m_head + m_metrics.depth) % m_capacity, message);
+        m_metrics.maxDepth = std::max(m_metrics.maxDepth, ++m_metrics.depth);
+        signal = schedule();
+    }
+
+    if (signal)
+    {
+        signalScheduler();
+    }
+
+    return Error::success;
+}
+
+template <typename Msg, class Pool> void Actor<Msg, Pool>::dispatch()
+{
+    // only this worker takes messages out, so the message stays in place while it is processed.
+    auto messagePtr{m_mailbox + m_head};
+    messageCallback(*messagePtr);
+    std::destroy_at(messagePtr);
+
+    Kernel::CriticalSection cs;
+    m_head = (m_head + 1) % m_capacity;
+    --m_metrics.depth;
+}
+} // namespace ThreadX
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "eventFlags.hpp"
+#include "queue.hpp"
+#include "semaphore.hpp"
+#include "txCommon.hpp"
+#include <functional>
+#include <limits>
+
+namespace ThreadX
+{
+class CoroutineAwaiter;
+class CoroutineSchedulerBase;
+
+/// Part of the objects that coroutines of a CoroutineScheduler wait on. The object signals from its notify callback when
+/// a message is sent, an instance released or flags set, and the scheduler then tries the operations of the coroutines
+/// waiting for it, rather than polling them. Only the Awaitable variants of the objects pay for this.
+class Awaitable
+{
+  protected:
+    Awaitable() = default;
+
+    /// coroutines must not wait on the object any more.
+    ~Awaitable();
+
+    /// makes the scheduler of the coroutines waiting for the object try their operations again. May be called from ISRs.
+    void signal();
+
+    /// \return notify callback that calls callback, if there is one, and then signals
+    template <class Object> std::function<void(Object &)> signalling(const std::function<void(Object &)> &callback);
+
+  private:
+    friend class CoroutineSchedulerBase;
+
+    CoroutineSchedulerBase *m_schedulerPtr{}; // of the waiting coroutines, while there are any or it is signalled
+    CoroutineAwaiter *m_awaitersHead{};       // waiting coroutines in FIFO order, only used by the scheduler thread
+    CoroutineAwaiter *m_awaitersTail{};
+    Awaitable *m_signalledNext{};
+    bool m_signalled{};
+};
+
+/// Queue that coroutines can co_await with Await::receive().
+template <typename Msg, class Pool> class AwaitableQueue : public Awaitable, public Queue<Msg, Pool>
+{
+  public:
+    using NotifyCallback = typename Queue<Msg, Pool>::NotifyCallback;
+
+    explicit AwaitableQueue(const std::string_view name, Pool &pool, const Ulong queueSizeInNumOfMessages, const NotifyCallback &sendNotifyCallback = {})
+        requires(std::is_base_of_v<BytePoolBase, Pool>);
+    explicit AwaitableQueue(const std::string_view name, Pool &pool, const NotifyCallback &sendNotifyCallback = {})
+        requires(std::is_base_of_v<BlockPoolBase, Pool>);
+};
+
+/// CountingSemaphore that coroutines can co_await with Await::acquire().
+template <Ulong Ceiling = std::numeric_limits<Ulong>::max()> class AwaitableSemaphore : public Awaitable, public CountingSemaphore<Ceiling>
+{
+  public:
+    using NotifyCallback = typename CountingSemaphore<Ceiling>::NotifyCallback;
+
+    explicit AwaitableSemaphore(const std::string_view name, const Ulong initialCount = 0, const NotifyCallback &releaseNotifyCallback = {});
+};
+
+using AwaitableBinarySemaphore = AwaitableSemaphore<1>;
+
+/// EventFlags that coroutines can co_await with Await::waitAny() and Await::waitAll().
+class AwaitableEventFlags : public Awaitable, public EventFlags
+{
+  public:
+    explicit AwaitableEventFlags(const std::string_view name, const NotifyCallback &setNotifyCallback = {});
+};
+
+template <class Object> std::function<void(Object &)> Awaitable::signalling(const std::function<void(Object &)> &callback)
+{
+    return [this, callback](Object &object) {
+        if (callback)
+        {
+            callback(object);
+        }
+
+        signal();
+    };
+}
+
+template <typename Msg, class Pool>
+AwaitableQueue<Msg, Pool>::AwaitableQueue(const std::string_view name, Pool &pool, const Ulong queueSizeInNumOfMessages, const NotifyCallback &sendNotifyCallback)
+    requires(std::is_base_of_v<BytePoolBase, Pool>)
+    : Queue<Msg, Pool>{name, pool, queueSizeInNumOfMessages, signalling(sendNotifyCallback)}
+{
+}
+
+template <typename Msg, class Pool>
+AwaitableQueue<Msg, Pool>::AwaitableQueue(const std::string_view name, Pool &pool, const NotifyCallback &sendNotifyCallback)
+    requires(std::is_base_of_v<BlockPoolBase, Pool>)
+    : Queue<Msg, Pool>{name, pool, signalling(sendNotifyCallback)}
+{
+}
+
+template <Ulong Ceiling>
+AwaitableSemaphore<Ceiling>::AwaitableSemaphore(const std::string_view name, const Ulong initialCount, const NotifyCallback &releaseNotifyCallback)
+    : CountingSemaphore<Ceiling>{name, initialCount, signalling(releaseNotifyCallback)}
+{
+}
+} // namespace ThreadX
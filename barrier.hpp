@@ -0,0 +1,121 @@
+#pragma once
+
+#include "eventFlags.hpp"
+#include "txCommon.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+namespace ThreadX
+{
+/// Default completion function of Barrier, does nothing.
+struct BarrierNoCompletion
+{
+    void operator()() noexcept
+    {
+    }
+};
+
+/// Reusable thread barrier, equivalent to std::barrier. Each phase completes when the expected number of threads have
+/// arrived. The last thread to arrive runs the completion function, and then releases the others.
+/// Phases alternate between two event flags, so a phase costs one event flags set and clear, and allocates nothing.
+/// \tparam CompletionFunction called with no arguments, once per phase
+template <class CompletionFunction = BarrierNoCompletion> class Barrier
+{
+  public:
+    /// parity of the phase the arrival belongs to
+    using arrival_token = Ulong;
+
+    explicit Barrier(const std::ptrdiff_t expected, CompletionFunction completion = CompletionFunction(), const std::string_view name = "barrier");
+
+    Barrier(const Barrier &) = delete;
+    Barrier &operator=(const Barrier &) = delete;
+
+    static constexpr std::ptrdiff_t max() noexcept;
+
+    /// arrives at the current phase without waiting.
+    [[nodiscard]] arrival_token arrive(const std::ptrdiff_t update = 1);
+
+    /// blocks until the phase of the arrival has completed.
+    void wait(arrival_token &&arrival) const;
+
+    void arrive_and_wait();
+
+    /// arrives at the current phase and decrements the expected count of the following phases.
+    void arrive_and_drop();
+
+  private:
+    static EventFlags::Bitmask phaseBit(const arrival_token phase);
+
+    std::atomic<std::ptrdiff_t> m_expected;
+    std::atomic<std::ptrdiff_t> m_remaining;
+    std::atomic<arrival_token> m_phase{};
+    CompletionFunction m_completion;
+    mutable EventFlags m_eventFlags;
+};
+
+template <class CompletionFunction>
+Barrier<CompletionFunction>::Barrier(const std::ptrdiff_t expected, CompletionFunction completion, const std::string_view name)
+    : m_expected{expected}, m_remaining{expected}, m_completion{std::move(completion)}, m_eventFlags{name}
+{
+    assert(expected >= 0);
+}
+
+template <class CompletionFunction> constexpr std::ptrdiff_t Barrier<CompletionFunction>::max() noexcept
+{
+    return std::numeric_limits<std::ptrdiff_t>::max();
+}
+
+template <class CompletionFunction> auto Barrier<CompletionFunction>::arrive(const std::ptrdiff_t update) -> arrival_token
+{
+    const auto phase{m_phase.load()};
+    const auto previous{m_remaining.fetch_sub(update)};
+    assert(previous >= update);
+
+    if (previous == update)
+    {
+        m_completion();
+
+        // the flag of the next phase was set two phases ago, and every thread has left that phase since it arrived here.
+        m_remaining = m_expected.load();
+        [[maybe_unused]] auto error{m_eventFlags.clear(phaseBit(phase + 1))};
+        assert(error == Error::success);
+        m_phase = phase + 1;
+
+        error = m_eventFlags.set(phaseBit(phase));
+        assert(error == Error::success);
+    }
+
+    return phase;
+}
+
+template <class CompletionFunction> void Barrier<CompletionFunction>::wait(arrival_token &&arrival) const
+{
+    if (m_phase.load() != arrival)
+    {
+        return;
+    }
+
+    [[maybe_unused]] auto [error, flags]{m_eventFlags.waitAll(phaseBit(arrival), EventFlags::Option::dontClear)};
+    assert(error == Error::success);
+}
+
+template <class CompletionFunction> void Barrier<CompletionFunction>::arrive_and_wait()
+{
+    wait(arrive());
+}
+
+template <class CompletionFunction> void Barrier<CompletionFunction>::arrive_and_drop()
+{
+    --m_expected;
+    [[maybe_unused]] auto phase{arrive()};
+}
+
+template <class CompletionFunction> EventFlags::Bitmask Barrier<CompletionFunction>::phaseBit(const arrival_token phase)
+{
+    return EventFlags::Bitmask{1UL << (phase & 1)};
+}
+} // namespace ThreadX
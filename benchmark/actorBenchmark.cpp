@@ -0,0 +1,95 @@
+// Measures the messages per second that pairs of actors bouncing a message between them get through an ActorRuntime,
+// for a growing number of worker threads, with the mailbox and processing time metrics of one actor.
+
+#include "actor.hpp"
+#include "benchmark.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr size_t pairs{4};
+constexpr Ulong mailboxCapacity{4};
+
+class PingPong : public Actor<Ulong, Benchmark::Pool>
+{
+  public:
+    PingPong(ActorScheduler &scheduler, Benchmark::Pool &pool, const std::atomic_bool &stop, std::atomic<Ulong> &messages)
+        : Actor{scheduler, pool, mailboxCapacity}, m_stop{stop}, m_messages{messages}
+    {
+    }
+
+    PingPong *m_peerPtr{};
+
+  private:
+    void messageCallback(const Ulong &message) final
+    {
+        m_messages.fetch_add(1, std::memory_order_relaxed);
+        if (not m_stop)
+        {
+            [[maybe_unused]] auto error{m_peerPtr->post(message + 1)};
+        }
+    }
+
+    const std::atomic_bool &m_stop;
+    std::atomic<Ulong> &m_messages;
+};
+
+template <size_t Workers> void run(Benchmark::Pool &pool)
+{
+    std::atomic_bool stop{};
+    std::atomic<Ulong> messages{};
+
+    ActorRuntime<Benchmark::Pool, Workers> runtime{"actorRuntime", pool, Benchmark::stackSize, workerPriority};
+    std::array<std::optional<PingPong>, 2 * pairs> actors;
+    for (auto &actor : actors)
+    {
+        actor.emplace(runtime, pool, stop, messages);
+    }
+
+    for (size_t pair{}; pair < pairs; ++pair)
+    {
+        actors[2 * pair]->m_peerPtr = std::addressof(*actors[2 * pair + 1]);
+        actors[2 * pair + 1]->m_peerPtr = std::addressof(*actors[2 * pair]);
+        [[maybe_unused]] auto error{actors[2 * pair]->post(0)};
+    }
+
+    ThisThread::sleepFor(period);
+    stop = true;
+
+    // the last messages are processed without replies, after which the actors are idle and can be destroyed.
+    ThisThread::sleepFor(TickTimer::Duration{2});
+
+    std::array<char, 32> testCase{};
+    std::snprintf(testCase.data(), testCase.size(), "%zu workers", Workers);
+    Benchmark::report("ActorRuntime", testCase.data(), double(messages), "messages/s");
+
+    const auto metrics{actors.front()->metrics()};
+    std::snprintf(testCase.data(), testCase.size(), "%zu workers max depth", Workers);
+    Benchmark::report("ActorRuntime", testCase.data(), double(metrics.maxDepth), "messages");
+    std::snprintf(testCase.data(), testCase.size(), "%zu workers max processing", Workers);
+    Benchmark::report("ActorRuntime", testCase.data(), double(metrics.maxProcessingTime), "us");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    run<1>(pool);
+    run<2>(pool);
+    run<4>(pool);
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"actorBenchmark", pool, []() { run(pool); }};
+}
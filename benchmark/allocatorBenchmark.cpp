@@ -0,0 +1,376 @@
+// Replays allocation traces against BytePool and BlockPool of the same size, to choose pool sizes from evidence.
+// A trace is a list of allocations, each with a size, a lifetime counted in later allocations of the same thread, and
+// the thread that makes it. Synthetic traces are generated from a seed, so a run can be repeated exactly. On a host
+// port, ALLOCATOR_SEED sets the seed and ALLOCATOR_TRACE names a recorded trace, one "thread,size,lifetime" line per
+// allocation, where a lifetime of 0 lasts to the end. The trace threads take turns after every allocation.
+// Every allocator and trace prints the allocation and release latency, the peak fragmentation (the part of the free
+// memory outside the largest free fragment), the peak memory in use and the allocation failures.
+
+#include "benchmark.hpp"
+#include "highResClock.hpp"
+#include "histogram.hpp"
+#include "memoryPool.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <span>
+
+namespace
+{
+using namespace ThreadX;
+using std::chrono::nanoseconds;
+
+constexpr std::uint32_t defaultSeed{1};
+constexpr size_t traceThreads{3};
+constexpr size_t maxOperations{2048};
+constexpr size_t syntheticOperations{1024};
+constexpr size_t maxLive{64}; // allocations a thread holds at most. The one closest to expiring is released to make room.
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr size_t bins{256};
+constexpr Ulong binWidth{100}; // ns
+
+constexpr Ulong poolSize{16 * 1024};
+constexpr Ulong smallBlock{128};
+constexpr Ulong largeBlock{1024};
+
+using LatencyHistogram = Histogram<bins>;
+using Bytes = BytePool<poolSize>;
+using SmallBlocks = BlockPool<(poolSize / (smallBlock + sizeof(std::byte *))) * (smallBlock + sizeof(std::byte *)), smallBlock>;
+using LargeBlocks = BlockPool<(poolSize / (largeBlock + sizeof(std::byte *))) * (largeBlock + sizeof(std::byte *)), largeBlock>;
+
+struct Operation
+{
+    Uint thread;
+    Ulong size;
+    Ulong lifetime; // zero for the whole trace
+};
+
+struct Profile
+{
+    std::string_view name;
+    Ulong minSize;
+    Ulong maxSize;
+    Ulong maxLifetime;
+    Uint longLivedPercent; ///< allocations that last to the end of the trace
+};
+
+constexpr std::array profiles{Profile{"small", 8, smallBlock, 8, 0}, Profile{"mixed", 8, largeBlock, 32, 0}, Profile{"longLived", 8, largeBlock / 2, 16, 10}};
+
+/// xorshift32, so that a seed gives the same trace with every compiler and standard library.
+class Random
+{
+  public:
+    explicit Random(const std::uint32_t seed) : m_state{seed != 0 ? seed : defaultSeed}
+    {
+    }
+
+    /// \return a number from min to max, both included
+    Ulong between(const Ulong min, const Ulong max)
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return min + m_state % (max - min + 1);
+    }
+
+  private:
+    std::uint32_t m_state;
+};
+
+struct Live
+{
+    std::byte *memoryPtr;
+    Ulong size;
+    Ulong remaining; // allocations of the thread until it is released
+};
+
+struct Result
+{
+    Ulong failures;
+    std::optional<size_t> firstFailure; // index of the operation
+    Ulong inUseAtFirstFailure;
+    Ulong inUse;
+    Ulong peakInUse;
+    Ulong peakFragmentation; // percent
+};
+
+// kept out of the worker stacks. The trace threads switch only when they yield, so they share these without locking.
+std::array<Operation, maxOperations> operations;
+std::array<std::array<Live, maxLive>, traceThreads> live;
+std::array<std::optional<Benchmark::Runner>, traceThreads> workers;
+LatencyHistogram allocationLatency{binWidth};
+LatencyHistogram releaseLatency{binWidth};
+Result result;
+
+class BytePoolAllocator
+{
+  public:
+    static constexpr std::string_view name{"BytePool"};
+
+    std::byte *allocate(const Ulong size)
+    {
+        auto [error, memoryPtr]{m_pool.allocate(size)};
+        return memoryPtr;
+    }
+
+    void release(std::byte *const memoryPtr)
+    {
+        [[maybe_unused]] auto error{Bytes::release(memoryPtr)};
+        assert(error == Error::success);
+    }
+
+    Ulong fragmentation() const
+    {
+        const auto info{m_pool.info()};
+        return info.available > 0 ? 100 - Ulong(Ulong64{info.largestFree} * 100 / info.available) : 0;
+    }
+
+  private:
+    Bytes m_pool{"bytes"};
+};
+
+/// a block pool never fragments, but wastes the part of every block the allocation does not use, and fails for
+/// allocations larger than a block.
+template <class Pool> class BlockPoolAllocator
+{
+  public:
+    explicit BlockPoolAllocator(const std::string_view name) : name{name}, m_pool{name}
+    {
+    }
+
+    std::byte *allocate(const Ulong size)
+    {
+        if (size > m_pool.blockSize())
+        {
+            return nullptr;
+        }
+
+        auto [error, memoryPtr]{m_pool.allocate()};
+        return memoryPtr;
+    }
+
+    void release(std::byte *const memoryPtr)
+    {
+        [[maybe_unused]] auto error{Pool::release(memoryPtr)};
+        assert(error == Error::success);
+    }
+
+    Ulong fragmentation() const
+    {
+        return 0;
+    }
+
+    const std::string_view name;
+
+  private:
+    Pool m_pool;
+};
+
+std::span<const Operation> generate(const Profile &profile, const std::uint32_t seed)
+{
+    Random random{seed};
+    for (size_t index{}; index < syntheticOperations; ++index)
+    {
+        auto &operation{operations[index]};
+        operation.thread = Uint(random.between(0, traceThreads - 1));
+        operation.size = random.between(profile.minSize, profile.maxSize);
+        operation.lifetime = random.between(1, 100) <= profile.longLivedPercent ? 0 : random.between(1, profile.maxLifetime);
+    }
+
+    return {operations.data(), syntheticOperations};
+}
+
+/// reads the trace named by ALLOCATOR_TRACE. \return the operations, none if there is no trace
+std::span<const Operation> load()
+{
+    size_t count{};
+#ifdef __linux__
+    if (const auto path{std::getenv("ALLOCATOR_TRACE")}; path)
+    {
+        if (auto file{std::fopen(path, "r")}; file)
+        {
+            for (unsigned thread{}, size{}, lifetime{}; count < maxOperations and std::fscanf(file, "%u,%u,%u", &thread, &size, &lifetime) == 3; ++count)
+            {
+                operations[count] = Operation{.thread = Uint(thread % traceThreads), .size = size, .lifetime = lifetime};
+            }
+
+            std::fclose(file);
+        }
+    }
+#endif
+    return {operations.data(), count};
+}
+
+std::uint32_t seed()
+{
+#ifdef __linux__
+    if (const auto value{std::getenv("ALLOCATOR_SEED")}; value)
+    {
+        return std::uint32_t(std::strtoul(value, nullptr, 0));
+    }
+#endif
+    return defaultSeed;
+}
+
+Ulong nanosecondsSince(const HighResClock::TimePoint start)
+{
+    return Ulong(std::chrono::duration_cast<nanoseconds>(HighResClock::now() - start).count());
+}
+
+template <class Allocator> void release(Allocator &allocator, Live &allocation)
+{
+    const auto start{HighResClock::now()};
+    allocator.release(allocation.memoryPtr);
+    releaseLatency.insert(nanosecondsSince(start));
+
+    result.inUse -= allocation.size;
+    allocation = Live{};
+}
+
+/// makes the allocation of one operation, after releasing the allocations of the thread that have expired.
+template <class Allocator> void replay(Allocator &allocator, const Operation &operation, const size_t index)
+{
+    auto &held{live[operation.thread]};
+    for (auto &allocation : held)
+    {
+        if (allocation.memoryPtr and --allocation.remaining == 0)
+        {
+            release(allocator, allocation);
+        }
+    }
+
+    auto slot{std::ranges::find(held, nullptr, &Live::memoryPtr)};
+    if (slot == held.end())
+    {
+        slot = std::ranges::min_element(held, {}, &Live::remaining);
+        release(allocator, *slot);
+    }
+
+    const auto start{HighResClock::now()};
+    const auto memoryPtr{allocator.allocate(operation.size)};
+    allocationLatency.insert(nanosecondsSince(start));
+
+    if (not memoryPtr)
+    {
+        if (result.failures++ == 0)
+        {
+            result.firstFailure = index;
+            result.inUseAtFirstFailure = result.inUse;
+        }
+    }
+    else
+    {
+        *slot = Live{.memoryPtr = memoryPtr, .size = operation.size, .remaining = operation.lifetime > 0 ? operation.lifetime : std::numeric_limits<Ulong>::max()};
+        result.inUse += operation.size;
+        result.peakInUse = std::max(result.peakInUse, result.inUse);
+    }
+
+    result.peakFragmentation = std::max(result.peakFragmentation, allocator.fragmentation());
+}
+
+void report(const std::string_view allocator, const std::string_view trace)
+{
+    std::array<char, 64> name{};
+    auto line = [&](const std::string_view statistic, const double value, const std::string_view unit) {
+        std::snprintf(name.data(), name.size(), "%.*s %.*s %.*s", int(allocator.size()), allocator.data(), int(trace.size()), trace.data(), int(statistic.size()), statistic.data());
+        Benchmark::report("Allocator", name.data(), value, unit);
+    };
+
+    line("allocate p50", double(allocationLatency.percentile(50)), "ns");
+    line("allocate p99", double(allocationLatency.percentile(99)), "ns");
+    line("allocate max", double(allocationLatency.max()), "ns");
+    line("release p50", double(releaseLatency.percentile(50)), "ns");
+    line("release p99", double(releaseLatency.percentile(99)), "ns");
+    line("release max", double(releaseLatency.max()), "ns");
+    line("peak fragmentation", double(result.peakFragmentation), "%");
+    line("peak in use", double(result.peakInUse), "bytes");
+    line("failures", double(result.failures), "allocations");
+    if (result.firstFailure)
+    {
+        line("first failure", double(*result.firstFailure), "operation");
+        line("in use at first failure", double(result.inUseAtFirstFailure), "bytes");
+    }
+}
+
+/// replays the trace on one thread per trace thread, which take turns after every operation.
+template <class Allocator> void run(Allocator &allocator, const std::string_view traceName, const std::span<const Operation> trace, Benchmark::Pool &pool)
+{
+    allocationLatency.clear();
+    releaseLatency.clear();
+    result = Result{};
+
+    for (size_t thread{}; thread < traceThreads; ++thread)
+    {
+        workers[thread].emplace("trace", pool,
+                                [&allocator, trace, thread]() {
+                                    for (size_t index{}; index < trace.size(); ++index)
+                                    {
+                                        if (trace[index].thread == thread)
+                                        {
+                                            replay(allocator, trace[index], index);
+                                        }
+
+                                        ThisThread::yield();
+                                    }
+                                },
+                                workerPriority);
+    }
+
+    for (auto &worker : workers)
+    {
+        worker->join();
+        worker.reset();
+    }
+
+    for (auto &held : live)
+    {
+        for (auto &allocation : held)
+        {
+            if (allocation.memoryPtr)
+            {
+                release(allocator, allocation);
+            }
+        }
+    }
+
+    report(allocator.name, traceName);
+}
+
+void run(Benchmark::Pool &pool)
+{
+    static BytePoolAllocator bytes;
+    static BlockPoolAllocator<SmallBlocks> smallBlocks{"BlockPool128"};
+    static BlockPoolAllocator<LargeBlocks> largeBlocks{"BlockPool1024"};
+
+    const auto traceSeed{seed()};
+    Benchmark::report("Allocator", "seed", double(traceSeed), "");
+
+    for (const auto &profile : profiles)
+    {
+        const auto trace{generate(profile, traceSeed)};
+        run(bytes, profile.name, trace, pool);
+        run(smallBlocks, profile.name, trace, pool);
+        run(largeBlocks, profile.name, trace, pool);
+    }
+
+    if (const auto trace{load()}; not trace.empty())
+    {
+        run(bytes, "recorded", trace, pool);
+        run(smallBlocks, "recorded", trace, pool);
+        run(largeBlocks, "recorded", trace, pool);
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"allocatorBenchmark", pool, []() { run(pool); }};
+}
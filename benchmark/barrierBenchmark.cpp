@@ -0,0 +1,74 @@
+// Measures the phases per second that a Barrier completes as the number of threads synchronising on it grows.
+
+#include "barrier.hpp"
+#include "benchmark.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr std::array threadCounts{1, 2, 4, 6};
+constexpr size_t maxThreads{6};
+
+void run(const int threads, Benchmark::Pool &pool)
+{
+    std::atomic_bool stop{};
+    std::atomic_bool done{};
+    Ulong phases{};
+
+    // done only changes when a phase completes, so all workers see the same value and leave after the same phase.
+    Barrier<std::function<void()>> barrier{threads, [&]() {
+                                               ++phases;
+                                               done = stop.load();
+                                           }};
+
+    std::array<std::optional<Benchmark::Runner>, maxThreads> workers;
+    for (int worker{}; worker < threads; ++worker)
+    {
+        workers[worker].emplace("worker", pool,
+                                [&]() {
+                                    do
+                                    {
+                                        barrier.arrive_and_wait();
+                                    } while (not done);
+                                },
+                                workerPriority);
+    }
+
+    ThisThread::sleepFor(period);
+    stop = true;
+
+    for (int worker{}; worker < threads; ++worker)
+    {
+        workers[worker]->join();
+    }
+
+    std::array<char, 16> testCase{};
+    std::snprintf(testCase.data(), testCase.size(), "%d threads", threads);
+    Benchmark::report("Barrier", testCase.data(), double(phases), "phases/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    for (const auto threads : threadCounts)
+    {
+        run(threads, pool);
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"barrierBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "memoryPool.hpp"
+#include "thread.hpp"
+#include "tickTimer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+namespace ThreadX::Benchmark
+{
+inline constexpr Ulong stackSize{2048};
+inline constexpr Uint runnerPriority{8}; ///< priority of the thread that runs the cases. Worker threads go below it.
+inline constexpr Ulong iterationBatch{64}; ///< iterations between two clock reads
+
+using Pool = BytePool<12 * stackSize>; // room for the runner and up to ten worker threads
+
+/// Thread that runs a function, for the benchmark runner and its worker threads.
+class Runner : public Thread<Pool>
+{
+  public:
+    using Body = std::function<void()>;
+
+    explicit Runner(const std::string_view name, Pool &pool, const Body &body, const Uint priority = runnerPriority);
+
+  private:
+    void entryCallback() final;
+
+    const Body m_body;
+};
+
+inline Runner::Runner(const std::string_view name, Pool &pool, const Body &body, const Uint priority)
+    : Thread<Pool>{name, pool, stackSize, {}, priority, priority, noTimeSlice, ThreadStartType::dontStart}, m_body{body}
+{
+    // the thread is created suspended so that it cannot run before m_body is constructed.
+    [[maybe_unused]] auto error{resume()};
+    assert(error == Error::success);
+}
+
+inline void Runner::entryCallback()
+{
+    m_body();
+}
+
+/// Repeats an operation for a measurement period, in the style of Thread-Metric, and returns the number of repetitions.
+/// The period starts on a tick edge, and the clock is read once per iterationBatch to keep it out of the result.
+template <typename Operation> Ulong iterationsFor(const TickTimer::Duration period, Operation &&operation)
+{
+    for (const auto start{TickTimer::now()}; TickTimer::now() == start;)
+    {
+    }
+
+    const auto end{TickTimer::now() + period};
+    Ulong iterations{};
+    while (TickTimer::now() < end)
+    {
+        for (Ulong batch{}; batch < iterationBatch; ++batch)
+        {
+            operation();
+        }
+
+        iterations += iterationBatch;
+    }
+
+    return iterations;
+}
+
+/// Prints one CSV result line, after a header line on the first call.
+inline void report(const std::string_view benchmark, const std::string_view testCase, const double value, const std::string_view unit)
+{
+    static bool headerPrinted{};
+    if (not std::exchange(headerPrinted, true))
+    {
+        std::printf("benchmark,case,value,unit\n");
+    }
+
+    std::printf("%.*s,%.*s,%.1f,%.*s\n", int(benchmark.size()), benchmark.data(), int(testCase.size()), testCase.data(), value, int(unit.size()), unit.data());
+}
+
+/// Called by the runner after the last case. Exits the process when running on a host port, otherwise it parks the runner.
+inline void finish()
+{
+    std::fflush(stdout);
+#ifdef __linux__
+    std::exit(EXIT_SUCCESS);
+#else
+    [[maybe_unused]] auto error{Native::tx_thread_suspend(Native::tx_thread_identify())};
+#endif
+}
+} // namespace ThreadX::Benchmark
@@ -0,0 +1,114 @@
+// Counts the context switches caused by a high priority thread locking a mutex that a low priority thread holds most
+// of the time, with priority inheritance (Mutex) and with the immediate priority ceiling (ImmediateCeilingMutex).
+// Needs TX_THREAD_ENABLE_PERFORMANCE_INFO in tx_user.h, without which only the jobs are reported.
+
+#include "benchmark.hpp"
+#include "immediateCeilingMutex.hpp"
+#include "mutex.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint highPriority{Benchmark::runnerPriority + 1};
+constexpr Uint lowPriority{Benchmark::runnerPriority + 2};
+constexpr Ulong holdIterations{1000};
+
+struct Switches
+{
+    Ulong suspensions;
+    Ulong preemptions;
+    Ulong priorityInversions;
+};
+
+Switches switches()
+{
+    Switches result{};
+#ifdef TX_THREAD_ENABLE_PERFORMANCE_INFO
+    Ulong solicitedPreemptions{};
+    Ulong interruptPreemptions{};
+    [[maybe_unused]] Error error{Native::tx_thread_performance_system_info_get(nullptr, std::addressof(result.suspensions), std::addressof(solicitedPreemptions), std::addressof(interruptPreemptions),
+                                                                               std::addressof(result.priorityInversions), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)};
+    result.preemptions = solicitedPreemptions + interruptPreemptions;
+#endif
+    return result;
+}
+
+template <class Lockable> void run(const std::string_view name, Benchmark::Pool &pool, Lockable &mutex)
+{
+    std::atomic_bool stop{};
+    std::atomic<Ulong> work{};
+    Ulong jobs{};
+
+    // the low priority thread holds the mutex most of the time, so the high priority one usually wakes up while it is held.
+    Benchmark::Runner low{"low", pool,
+                          [&]() {
+                              while (not stop)
+                              {
+                                  mutex.lock();
+                                  for (Ulong iteration{}; iteration < holdIterations; ++iteration)
+                                  {
+                                      work.fetch_add(1, std::memory_order_relaxed);
+                                  }
+                                  mutex.unlock();
+                              }
+                          },
+                          lowPriority};
+
+    Benchmark::Runner high{"high", pool,
+                           [&]() {
+                               while (not stop)
+                               {
+                                   ThisThread::sleepFor(TickTimer::Duration{1});
+                                   mutex.lock();
+                                   mutex.unlock();
+                                   ++jobs;
+                               }
+                           },
+                           highPriority};
+
+    [[maybe_unused]] const auto before{switches()};
+    ThisThread::sleepFor(period);
+    [[maybe_unused]] const auto after{switches()};
+    stop = true;
+    high.join();
+    low.join();
+    jobs = std::max(jobs, Ulong{1});
+
+    Benchmark::report(name, "jobs", double(jobs), "count");
+#ifndef TX_THREAD_ENABLE_PERFORMANCE_INFO
+    // the counts would all be zero.
+    std::fprintf(stderr, "%.*s: context switch counts unavailable without TX_THREAD_ENABLE_PERFORMANCE_INFO\n", int(name.size()), name.data());
+#else
+    Benchmark::report(name, "suspensions", double(after.suspensions - before.suspensions) / double(jobs), "per job");
+    Benchmark::report(name, "preemptions", double(after.preemptions - before.preemptions) / double(jobs), "per job");
+    Benchmark::report(name, "priority inversions", double(after.priorityInversions - before.priorityInversions) / double(jobs), "per job");
+#endif
+}
+
+void run(Benchmark::Pool &pool)
+{
+    Mutex inheritMutex{InheritMode::inherit};
+    run("Mutex", pool, inheritMutex);
+
+    ImmediateCeilingMutex thresholdMutex{highPriority, CeilingMode::preemptionThreshold};
+    run("ImmediateCeilingMutex threshold", pool, thresholdMutex);
+
+    ImmediateCeilingMutex priorityMutex{highPriority, CeilingMode::priority};
+    run("ImmediateCeilingMutex priority", pool, priorityMutex);
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"ceilingMutexBenchmark", pool, []() { run(pool); }};
+}
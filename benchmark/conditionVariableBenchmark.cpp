@@ -0,0 +1,107 @@
+// Passes words from a producer to a consumer thread through a bounded buffer built from Mutex and ConditionVariable,
+// and through a Queue of the same capacity.
+
+#include "benchmark.hpp"
+#include "conditionVariable.hpp"
+#include "mutex.hpp"
+#include "queue.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr size_t capacity{16};
+constexpr Ulong endOfStream{~Ulong{}};
+
+class BoundedBuffer
+{
+  public:
+    void push(const Ulong value)
+    {
+        UniqueLock lock{m_mutex};
+        m_notFull.wait(lock, [this]() { return m_count < capacity; });
+        m_items[(m_head + m_count++) % capacity] = value;
+        m_notEmpty.notify_one();
+    }
+
+    Ulong pop()
+    {
+        UniqueLock lock{m_mutex};
+        m_notEmpty.wait(lock, [this]() { return m_count > 0; });
+        const auto value{m_items[m_head]};
+        m_head = (m_head + 1) % capacity;
+        --m_count;
+        m_notFull.notify_one();
+        return value;
+    }
+
+  private:
+    Mutex m_mutex;
+    ConditionVariable m_notFull;
+    ConditionVariable m_notEmpty;
+    std::array<Ulong, capacity> m_items{};
+    size_t m_head{};
+    size_t m_count{};
+};
+
+/// runs a producer and a consumer for the measurement period and reports the number of words passed.
+void run(const std::string_view name, Benchmark::Pool &pool, const std::function<void(Ulong)> &push, const std::function<Ulong()> &pop)
+{
+    std::atomic_bool stop{};
+    Ulong received{};
+
+    Benchmark::Runner consumer{"consumer", pool,
+                               [&]() {
+                                   while (pop() != endOfStream)
+                                   {
+                                       ++received;
+                                   }
+                               },
+                               workerPriority};
+
+    Benchmark::Runner producer{"producer", pool,
+                               [&]() {
+                                   for (Ulong value{}; not stop; ++value)
+                                   {
+                                       push(value);
+                                   }
+
+                                   push(endOfStream);
+                               },
+                               workerPriority};
+
+    ThisThread::sleepFor(period);
+    stop = true;
+    producer.join();
+    consumer.join();
+
+    Benchmark::report(name, "producer-consumer", double(received), "words/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    {
+        BoundedBuffer buffer;
+        run("ConditionVariable", pool, [&buffer](const Ulong value) { buffer.push(value); }, [&buffer]() { return buffer.pop(); });
+    }
+
+    {
+        Queue<Ulong, Benchmark::Pool> queue{"queue", pool, capacity};
+        run("Queue", pool, [&queue](const Ulong value) { queue.send(value); }, [&queue]() { return queue.receive().second; });
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"conditionVariableBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,116 @@
+// Bounces a token between two coroutines on one CoroutineScheduler through a pair of semaphores, and between two
+// threads through the same pair, and reports the round trips per second and the memory each side takes.
+
+#include "benchmark.hpp"
+#include "coroutine.hpp"
+#include "semaphore.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr Ulong frameSize{256};
+using FramePool = BlockPool<4 * (frameSize + sizeof(std::byte *)), frameSize>;
+
+std::atomic_bool stop{};
+std::atomic<Ulong> roundTrips{};
+std::atomic<Ulong> finished{};
+
+CoroutineTask pingPong(CoroutineSchedulerBase &, AwaitableBinarySemaphore &own, AwaitableBinarySemaphore &peer, const bool count)
+{
+    while (not stop)
+    {
+        co_await Await::acquire(own);
+        if (count)
+        {
+            roundTrips.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[maybe_unused]] auto error{peer.release()};
+    }
+
+    ++finished;
+}
+
+void runCoroutines(Benchmark::Pool &pool)
+{
+    FramePool framePool{"coroutineFrames"};
+    CoroutineScheduler scheduler{framePool};
+
+    AwaitableBinarySemaphore ping{"ping", 1};
+    AwaitableBinarySemaphore pong{"pong"};
+
+    [[maybe_unused]] auto error{scheduler.spawn(pingPong(scheduler, ping, pong, true))};
+    error = scheduler.spawn(pingPong(scheduler, pong, ping, false));
+
+    Benchmark::Runner runner{"scheduler", pool, [&scheduler]() { scheduler.run(); }, workerPriority};
+    ThisThread::sleepFor(period);
+    stop = true;
+    const auto trips{roundTrips.exchange(0)};
+
+    // the coroutines are woken until both have completed and freed their frames, so that no awaiter is left linked to
+    // the semaphores when they are destroyed.
+    while (finished < 2)
+    {
+        error = ping.release();
+        error = pong.release();
+        ThisThread::sleepFor(TickTimer::Duration{1});
+    }
+
+    Benchmark::report("Coroutine", "coroutines", double(trips), "round trips/s");
+    Benchmark::report("Coroutine", "coroutines", double(framePool.blockSize()), "bytes/session");
+}
+
+void runThreads(Benchmark::Pool &pool)
+{
+    stop = false;
+    BinarySemaphore ping{"ping", 1};
+    BinarySemaphore pong{"pong"};
+
+    auto body = [](BinarySemaphore &own, BinarySemaphore &peer, const bool count) {
+        while (not stop)
+        {
+            [[maybe_unused]] auto error{own.acquire()};
+            if (count)
+            {
+                roundTrips.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            error = peer.release();
+        }
+    };
+
+    Benchmark::Runner pinger{"pinger", pool, [&]() { body(ping, pong, true); }, workerPriority};
+    Benchmark::Runner ponger{"ponger", pool, [&]() { body(pong, ping, false); }, workerPriority};
+    ThisThread::sleepFor(period);
+    stop = true;
+
+    Benchmark::report("Coroutine", "threads", double(roundTrips.exchange(0)), "round trips/s");
+    Benchmark::report("Coroutine", "threads", double(Benchmark::stackSize), "bytes/session");
+
+    // one of the threads may be waiting for a token that never comes.
+    [[maybe_unused]] auto error{ping.release()};
+    error = pong.release();
+    pinger.join();
+    ponger.join();
+}
+
+void run(Benchmark::Pool &pool)
+{
+    runCoroutines(pool);
+    runThreads(pool);
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"coroutineBenchmark", pool, []() { run(pool); }};
+}
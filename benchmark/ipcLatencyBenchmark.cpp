@@ -0,0 +1,248 @@
+// Measures the latency of handing control from one thread to another with every primitive: Queue with messages of 1 to
+// 16 words, BinarySemaphore, EventFlags, Mutex ownership and Thread::resume(). The runner hands over to a responder
+// thread of the same, higher and lower priority, and of higher priority while the runner has a preemption-threshold
+// that keeps it out. The latency is from just before the handoff to the responder running, and every case prints its
+// p50, p99 and max. Queue, BinarySemaphore and EventFlags are ping-pongs, answered with the same primitive, for which
+// the round trips per second are printed too. Mutex and resume need the responder blocked again before each handoff,
+// which takes a sleep when it cannot run before the runner waits, so they have no throughput.
+
+#include "benchmark.hpp"
+#include "eventFlags.hpp"
+#include "highResClock.hpp"
+#include "histogram.hpp"
+#include "mutex.hpp"
+#include "queue.hpp"
+#include "semaphore.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using std::chrono::nanoseconds;
+
+constexpr size_t samples{256};
+constexpr size_t bins{512};
+constexpr Ulong binWidth{200}; // ns
+constexpr Uint initiatorPriority{Benchmark::runnerPriority};
+
+using LatencyHistogram = Histogram<bins>;
+
+struct Relation
+{
+    std::string_view name;
+    Uint responderPriority;
+    Uint initiatorThreshold; ///< preemption-threshold of the runner while it measures
+};
+
+constexpr std::array relations{Relation{"same", initiatorPriority, initiatorPriority}, Relation{"higher", initiatorPriority - 1, initiatorPriority},
+                               Relation{"lower", initiatorPriority + 1, initiatorPriority}, Relation{"higherThreshold", initiatorPriority - 1, initiatorPriority - 1}};
+
+// kept out of the runner's stack
+LatencyHistogram histogram{binWidth};
+std::optional<Benchmark::Runner> responder;
+HighResClock::TimePoint woken; // set by the responder when the handoff reaches it
+
+void report(const std::string_view mechanism, const Relation &relation, const std::optional<double> roundTrips)
+{
+    std::array<char, 48> name{};
+    auto line = [&](const std::string_view statistic, const double value, const std::string_view unit) {
+        std::snprintf(name.data(), name.size(), "%.*s %.*s %.*s", int(mechanism.size()), mechanism.data(), int(relation.name.size()), relation.name.data(), int(statistic.size()), statistic.data());
+        Benchmark::report("IpcLatency", name.data(), value, unit);
+    };
+
+    line("p50", double(histogram.percentile(50)), "ns");
+    line("p99", double(histogram.percentile(99)), "ns");
+    line("max", double(histogram.max()), "ns");
+    if (roundTrips)
+    {
+        line("throughput", *roundTrips, "round trips/s");
+    }
+}
+
+/// starts the responder, records samples handoffs and stops the responder.
+/// \param respond body of the responder, which answers handoffs until it is terminated
+/// \param handoff hands over to the responder and waits for its answer. \return time just before the handoff
+template <typename Handoff>
+void measure(const std::string_view mechanism, const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool, const bool pingPong, const Benchmark::Runner::Body &respond, Handoff &&handoff)
+{
+    histogram.clear();
+    responder.emplace("responder", pool, respond, relation.responderPriority);
+    ThisThread::sleepFor(TickTimer::Duration{1}); // lets a lower priority responder reach its first wait
+
+    [[maybe_unused]] auto error{initiator.preemption(relation.initiatorThreshold)};
+    const auto start{HighResClock::now()};
+    for (size_t sample{}; sample < samples; ++sample)
+    {
+        const auto sent{handoff()};
+        histogram.insert(Ulong(std::chrono::duration_cast<nanoseconds>(woken - sent).count()));
+    }
+    const auto seconds{std::chrono::duration<double>(HighResClock::now() - start).count()};
+    error = initiator.preemption(initiatorPriority);
+
+    responder.reset();
+    report(mechanism, relation, pingPong ? std::optional{double(samples) / seconds} : std::nullopt);
+}
+
+/// waits until the responder is blocked in state. It has to sleep if the responder cannot run before the runner waits.
+void waitForResponder(const ThreadState state)
+{
+    while (responder->state() != state)
+    {
+        ThisThread::sleepFor(TickTimer::Duration{1});
+    }
+}
+
+template <size_t Words> void queue(const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    using Message = std::array<Ulong, Words>;
+    Queue<Message, Benchmark::Pool> ping{"ping", pool, 1};
+    Queue<Message, Benchmark::Pool> pong{"pong", pool, 1};
+
+    std::array<char, 16> name{};
+    std::snprintf(name.data(), name.size(), "Queue%uW", unsigned(Words));
+    measure(
+        name.data(), relation, initiator, pool, true,
+        [&]() {
+            while (true)
+            {
+                auto [error, message]{ping.receive()};
+                woken = HighResClock::now();
+                error = pong.send(message);
+            }
+        },
+        [&]() {
+            const auto sent{HighResClock::now()};
+            [[maybe_unused]] auto error{ping.send(Message{})};
+            auto [received, message]{pong.receive()};
+            return sent;
+        });
+}
+
+void binarySemaphore(const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    BinarySemaphore ping{"ping"};
+    BinarySemaphore pong{"pong"};
+
+    measure(
+        "BinarySemaphore", relation, initiator, pool, true,
+        [&]() {
+            while (true)
+            {
+                [[maybe_unused]] auto error{ping.acquire()};
+                woken = HighResClock::now();
+                error = pong.release();
+            }
+        },
+        [&]() {
+            const auto sent{HighResClock::now()};
+            [[maybe_unused]] auto error{ping.release()};
+            error = pong.acquire();
+            return sent;
+        });
+}
+
+void eventFlags(const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    constexpr EventFlags::Bitmask pingBit{0b01};
+    constexpr EventFlags::Bitmask pongBit{0b10};
+    EventFlags flags{"pingPong"};
+
+    measure(
+        "EventFlags", relation, initiator, pool, true,
+        [&]() {
+            while (true)
+            {
+                auto [error, actual]{flags.waitAny(pingBit)};
+                woken = HighResClock::now();
+                error = flags.set(pongBit);
+            }
+        },
+        [&]() {
+            const auto sent{HighResClock::now()};
+            [[maybe_unused]] auto error{flags.set(pingBit)};
+            auto [received, actual]{flags.waitAny(pongBit)};
+            return sent;
+        });
+}
+
+// the runner unlocks the mutex while the responder waits for it, which makes the responder the owner.
+void mutexHandoff(const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    Mutex mutex{"handoff"};
+    BinarySemaphore go{"go"};
+    BinarySemaphore done{"done"};
+
+    measure(
+        "Mutex", relation, initiator, pool, false,
+        [&]() {
+            while (true)
+            {
+                [[maybe_unused]] auto error{go.acquire()};
+                error = mutex.lock();
+                woken = HighResClock::now();
+                error = mutex.unlock();
+                error = done.release();
+            }
+        },
+        [&]() {
+            [[maybe_unused]] auto error{mutex.lock()};
+            error = go.release();
+            waitForResponder(ThreadState::mutexSusp);
+            const auto sent{HighResClock::now()};
+            error = mutex.unlock();
+            error = done.acquire();
+            return sent;
+        });
+}
+
+void resume(const Relation &relation, Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    BinarySemaphore done{"done"};
+
+    measure(
+        "resume", relation, initiator, pool, false,
+        [&]() {
+            // a responder of higher priority runs before responder is assigned, so it suspends itself natively.
+            while (true)
+            {
+                [[maybe_unused]] Error error{Native::tx_thread_suspend(Native::tx_thread_identify())};
+                woken = HighResClock::now();
+                error = done.release();
+            }
+        },
+        [&]() {
+            waitForResponder(ThreadState::suspended);
+            const auto sent{HighResClock::now()};
+            [[maybe_unused]] auto error{responder->resume()};
+            error = done.acquire();
+            return sent;
+        });
+}
+
+void run(Benchmark::Runner &initiator, Benchmark::Pool &pool)
+{
+    for (const auto &relation : relations)
+    {
+        queue<1>(relation, initiator, pool);
+        queue<2>(relation, initiator, pool);
+        queue<4>(relation, initiator, pool);
+        queue<8>(relation, initiator, pool);
+        queue<16>(relation, initiator, pool);
+        binarySemaphore(relation, initiator, pool);
+        eventFlags(relation, initiator, pool);
+        mutexHandoff(relation, initiator, pool);
+        resume(relation, initiator, pool);
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"ipcLatencyBenchmark", pool, []() { run(runner, pool); }};
+}
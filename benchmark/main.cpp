@@ -0,0 +1,7 @@
+#include "kernel.hpp"
+
+int main()
+{
+    // each benchmark defines ThreadX::application(), which creates its runner thread.
+    ThreadX::Kernel::start();
+}
@@ -0,0 +1,72 @@
+// Compares the kernel Mutex with FastMutex, without contention and with two threads taking turns on the lock.
+
+#include "benchmark.hpp"
+#include "fastMutex.hpp"
+#include "mutex.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+
+template <class Lockable> void uncontended(const std::string_view name)
+{
+    Lockable mutex;
+    const auto iterations{Benchmark::iterationsFor(period, [&mutex]() {
+        mutex.lock();
+        mutex.unlock();
+    })};
+
+    Benchmark::report(name, "uncontended", double(iterations), "lock-unlock/s");
+}
+
+template <class Lockable> void contended(const std::string_view name, Benchmark::Pool &pool)
+{
+    Lockable mutex;
+    std::atomic_bool stop{};
+    std::array<Ulong, 2> iterations{};
+
+    // yielding while holding the lock makes the other thread block on it, yielding after releasing it lets that thread in.
+    auto body = [&](Ulong &count) {
+        while (not stop)
+        {
+            mutex.lock();
+            ThisThread::yield();
+            mutex.unlock();
+            ThisThread::yield();
+            ++count;
+        }
+    };
+
+    Benchmark::Runner first{"first", pool, [&]() { body(iterations[0]); }, workerPriority};
+    Benchmark::Runner second{"second", pool, [&]() { body(iterations[1]); }, workerPriority};
+
+    ThisThread::sleepFor(period);
+    stop = true;
+    first.join();
+    second.join();
+
+    Benchmark::report(name, "contended", double(iterations[0] + iterations[1]), "lock-unlock/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    uncontended<Mutex>("Mutex");
+    uncontended<FastMutex>("FastMutex");
+    contended<Mutex>("Mutex", pool);
+    contended<FastMutex>("FastMutex", pool);
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"mutexBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,89 @@
+// Runs a four stage pipeline of short stages, acquire, filter, compress and store, once with a thread per stage and
+// once with all stages fused onto one thread, and reports the items per second with the per-stage metrics.
+
+#include "benchmark.hpp"
+#include "pipeline.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr Ulong queueCapacity{16};
+
+using Pipeline = ThreadX::Pipeline<Ulong, Benchmark::Pool>;
+
+std::atomic<Ulong> stored{};
+
+bool acquire(Ulong &item)
+{
+    static Ulong sample{};
+    item = ++sample;
+    return true;
+}
+
+bool filter(Ulong &item)
+{
+    return item % 4 != 0;
+}
+
+bool compress(Ulong &item)
+{
+    item ^= item >> 3;
+    return true;
+}
+
+bool store(Ulong &)
+{
+    stored.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void run(const bool fused, Benchmark::Pool &pool)
+{
+    Pipeline pipeline{pool};
+    if (fused)
+    {
+        pipeline.stage("acquire", acquire, 1, workerPriority).fuse("filter", filter).fuse("compress", compress).fuse("store", store);
+    }
+    else
+    {
+        pipeline.stage("acquire", acquire, 1, workerPriority).stage("filter", filter, 1, workerPriority).stage("compress", compress, 1, workerPriority).stage("store", store, 1, workerPriority);
+    }
+
+    stored = 0;
+    pipeline.start(queueCapacity, Benchmark::stackSize);
+    ThisThread::sleepFor(period);
+
+    const auto name{fused ? std::string_view{"fused"} : std::string_view{"threaded"}};
+    Benchmark::report("Pipeline", name, double(stored), "items/s");
+    for (size_t stage{}; stage < pipeline.stages(); ++stage)
+    {
+        const auto metrics{pipeline.metrics(stage)};
+        std::array<char, 48> testCase{};
+        std::snprintf(testCase.data(), testCase.size(), "%.*s %.*s", int(name.size()), name.data(), int(pipeline.name(stage).size()), pipeline.name(stage).data());
+        Benchmark::report("Pipeline", testCase.data(), double(metrics.maxQueueDepth), "max queue depth");
+        Benchmark::report("Pipeline", testCase.data(), double(metrics.inputBlockedTime), "input blocked us");
+        Benchmark::report("Pipeline", testCase.data(), double(metrics.outputBlockedTime), "output blocked us");
+    }
+}
+
+void run(Benchmark::Pool &pool)
+{
+    run(false, pool);
+    run(true, pool);
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"pipelineBenchmark", pool, []() { run(pool); }};
+}
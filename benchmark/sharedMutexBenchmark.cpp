@@ -0,0 +1,101 @@
+// Compares read-side locking of SharedMutex with Mutex, with one reader and with several readers taking turns.
+
+#include "benchmark.hpp"
+#include "mutex.hpp"
+#include "sharedMutex.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr size_t readers{4};
+
+void lockShared(Mutex &mutex)
+{
+    mutex.lock();
+}
+
+void unlockShared(Mutex &mutex)
+{
+    mutex.unlock();
+}
+
+void lockShared(SharedMutex &mutex)
+{
+    mutex.lock_shared();
+}
+
+void unlockShared(SharedMutex &mutex)
+{
+    mutex.unlock_shared();
+}
+
+template <class Lockable> void singleReader(const std::string_view name)
+{
+    Lockable mutex;
+    const auto iterations{Benchmark::iterationsFor(period, [&mutex]() {
+        lockShared(mutex);
+        unlockShared(mutex);
+    })};
+
+    Benchmark::report(name, "single reader", double(iterations), "lock-unlock/s");
+}
+
+template <class Lockable> void concurrentReaders(const std::string_view name, Benchmark::Pool &pool)
+{
+    Lockable mutex;
+    std::atomic_bool stop{};
+    std::array<Ulong, readers> iterations{};
+
+    // readers yield while holding the lock, so that the others try to enter while it is held.
+    auto body = [&](Ulong &count) {
+        while (not stop)
+        {
+            lockShared(mutex);
+            ThisThread::yield();
+            unlockShared(mutex);
+            ++count;
+        }
+    };
+
+    std::array<std::optional<Benchmark::Runner>, readers> runners;
+    for (size_t reader{}; reader < readers; ++reader)
+    {
+        runners[reader].emplace("reader", pool, [&body, &iterations, reader]() { body(iterations[reader]); }, workerPriority);
+    }
+
+    ThisThread::sleepFor(period);
+    stop = true;
+
+    Ulong total{};
+    for (size_t reader{}; reader < readers; ++reader)
+    {
+        runners[reader]->join();
+        total += iterations[reader];
+    }
+
+    Benchmark::report(name, "concurrent readers", double(total), "lock-unlock/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    singleReader<Mutex>("Mutex");
+    singleReader<SharedMutex>("SharedMutex");
+    concurrentReaders<Mutex>("Mutex", pool);
+    concurrentReaders<SharedMutex>("SharedMutex", pool);
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"sharedMutexBenchmark", pool, []() { run(pool); }};
+}
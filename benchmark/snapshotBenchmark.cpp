@@ -0,0 +1,144 @@
+// Read throughput of a 200-byte state shared by four reader threads while a writer updates it every tick, protected by
+// Mutex, SeqLock and Snapshot.
+
+#include "benchmark.hpp"
+#include "mutex.hpp"
+#include "seqLock.hpp"
+#include "snapshot.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint writerPriority{Benchmark::runnerPriority + 1};
+constexpr Uint readerPriority{Benchmark::runnerPriority + 2};
+constexpr size_t readers{4};
+constexpr Ulong readerTimeSlice{1}; // ticks
+
+struct State
+{
+    std::array<Ulong, 200 / sizeof(Ulong)> values;
+};
+
+using StatePool = BlockPool<(readers + 4) * (snapshotBlockSize<State> + sizeof(std::byte *)), snapshotBlockSize<State>>;
+using StateSnapshot = Snapshot<State, StatePool, readers>;
+
+Ulong checksum(const State &state)
+{
+    Ulong sum{};
+    for (const auto value : state.values)
+    {
+        sum += value;
+    }
+
+    return sum;
+}
+
+State make(const Ulong version)
+{
+    State state;
+    state.values.fill(version);
+    return state;
+}
+
+/// \param read copies or references the state and returns its checksum
+void run(const std::string_view name, Benchmark::Pool &pool, const std::function<void(Ulong)> &write, const std::function<Ulong(size_t)> &read)
+{
+    std::atomic_bool stop{};
+    std::array<Ulong, readers> reads{};
+
+    std::array<std::optional<Benchmark::Runner>, readers> readerThreads;
+    for (size_t reader{}; reader < readers; ++reader)
+    {
+        readerThreads[reader].emplace("reader", pool,
+                                      [&, reader]() {
+                                          while (not stop)
+                                          {
+                                              [[maybe_unused]] volatile auto sum{read(reader)};
+                                              ++reads[reader];
+                                          }
+                                      },
+                                      readerPriority);
+
+        // the readers share a priority and never block, so they take turns every tick to read concurrently.
+        [[maybe_unused]] auto error{readerThreads[reader]->timeSlice(readerTimeSlice)};
+        assert(error == Error::success);
+    }
+
+    Benchmark::Runner writer{"writer", pool,
+                             [&]() {
+                                 for (Ulong version{}; not stop; ++version)
+                                 {
+                                     ThisThread::sleepFor(TickTimer::Duration{1});
+                                     write(version);
+                                 }
+                             },
+                             writerPriority};
+
+    ThisThread::sleepFor(period);
+    stop = true;
+    writer.join();
+
+    Ulong total{};
+    for (size_t reader{}; reader < readers; ++reader)
+    {
+        readerThreads[reader]->join();
+        total += reads[reader];
+    }
+
+    Benchmark::report(name, "reads", double(total), "reads/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    {
+        Mutex mutex;
+        State state{};
+        run("Mutex", pool,
+            [&](const Ulong version) {
+                LockGuard lock{mutex};
+                state = make(version);
+            },
+            [&](size_t) {
+                LockGuard lock{mutex};
+                return checksum(state);
+            });
+    }
+
+    {
+        SeqLock<State> seqLock;
+        run("SeqLock", pool, [&](const Ulong version) { seqLock.write(make(version)); }, [&](size_t) { return checksum(seqLock.read()); });
+    }
+
+    {
+        static StatePool statePool{"state"};
+        StateSnapshot snapshot{statePool};
+        std::array<std::optional<StateSnapshot::Reader>, readers> snapshotReaders;
+        for (auto &reader : snapshotReaders)
+        {
+            reader.emplace(snapshot);
+        }
+
+        run("Snapshot", pool, [&](const Ulong version) { [[maybe_unused]] auto error{snapshot.publish(make(version))}; },
+            [&](const size_t reader) {
+                auto state{snapshotReaders[reader]->read()};
+                return checksum(*state);
+            });
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"snapshotBenchmark", pool, []() { run(pool); }};
+}
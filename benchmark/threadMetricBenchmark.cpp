@@ -0,0 +1,382 @@
+// The Thread-Metric tests written with the wrapper classes, each next to the same test written with the native API.
+// The difference is the cost of the wrapper layer: std::function callbacks, returned pairs and Error conversions.
+// The interrupt tests call their handler from the thread, as there is no portable way to raise a software interrupt.
+// A semaphore put or a thread resume does the same work there as in an ISR, apart from the return through the scheduler.
+
+#include "benchmark.hpp"
+#include "eventFlags.hpp"
+#include "memoryPool.hpp"
+#include "mutex.hpp"
+#include "queue.hpp"
+#include "semaphore.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr size_t threadCount{5};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1}; // worker n runs at workerPriority + n, or all at workerPriority
+constexpr Ulong blockSize{128};
+constexpr Ulong blockPoolSize{4 * (blockSize + sizeof(std::byte *))};
+constexpr Ulong bytePoolSize{1024};
+
+using Message = std::array<Ulong, 4>; // 16 bytes, as in Thread-Metric
+using Blocks = BlockPool<blockPoolSize, blockSize>;
+using Bytes = BytePool<bytePoolSize>;
+
+std::atomic_bool stop;
+std::array<Ulong, threadCount> counts;
+
+// the workers are kept out of the runner's stack, which is too small for five of them.
+std::array<std::optional<Benchmark::Runner>, threadCount> runners;
+std::array<Native::TX_THREAD, threadCount> rawThreads;
+std::array<std::optional<Allocation<Benchmark::Pool>>, threadCount> rawStacks;
+
+Native::TX_SEMAPHORE rawSemaphore;
+Native::TX_MUTEX rawMutex;
+Native::TX_EVENT_FLAGS_GROUP rawEventFlags;
+Native::TX_QUEUE rawQueue;
+std::array<Message, 4> rawQueueStorage;
+Native::TX_BLOCK_POOL rawBlockPool;
+std::array<Ulong, blockPoolSize / wordSize> rawBlockPoolStorage;
+Native::TX_BYTE_POOL rawBytePool;
+std::array<Ulong, bytePoolSize / wordSize> rawBytePoolStorage;
+
+/// creates worker n with the native API. It starts right away, but runs only once the runner waits.
+void createRaw(const size_t n, Benchmark::Pool &pool, void (*const entry)(Ulong), const Uint priority)
+{
+    rawStacks[n].emplace(pool, Benchmark::stackSize);
+    [[maybe_unused]] Error error{Native::tx_thread_create(std::addressof(rawThreads[n]), const_cast<char *>("raw"), entry, n, rawStacks[n]->get(), Benchmark::stackSize, priority, priority,
+                                                          TX_NO_TIME_SLICE, TX_AUTO_START)};
+    assert(error == Error::success);
+}
+
+/// lets the workers run for the measurement period, then terminates them.
+/// \return sum of the counts of the workers that count
+Ulong measure()
+{
+    counts = {};
+    stop = false;
+    ThisThread::sleepFor(period);
+    stop = true;
+    const auto sum{std::accumulate(counts.begin(), counts.end(), Ulong{})};
+
+    for (auto &runner : runners)
+    {
+        runner.reset();
+    }
+
+    for (size_t n{}; n < threadCount; ++n)
+    {
+        if (rawStacks[n])
+        {
+            Native::tx_thread_terminate(std::addressof(rawThreads[n]));
+            Native::tx_thread_delete(std::addressof(rawThreads[n]));
+            rawStacks[n].reset();
+        }
+    }
+
+    return sum;
+}
+
+/// prints the wrapper and raw results of a test, and the extra time the wrapper takes per operation.
+void compare(const std::string_view test, const Ulong wrapper, const Ulong raw, const std::string_view unit)
+{
+    Benchmark::report(test, "wrapper", double(wrapper), unit);
+    Benchmark::report(test, "raw", double(raw), unit);
+    Benchmark::report(test, "overhead", wrapper > 0 ? 100.0 * (double(raw) / double(wrapper) - 1.0) : 0.0, "%");
+}
+
+// threads of the same priority that count and yield in turn.
+void cooperativeRaw(const Ulong n)
+{
+    while (not stop)
+    {
+        ++counts[n];
+        Native::tx_thread_relinquish();
+    }
+}
+
+void cooperativeScheduling(Benchmark::Pool &pool)
+{
+    for (size_t n{}; n < threadCount; ++n)
+    {
+        runners[n].emplace("cooperative", pool,
+                           [n]() {
+                               while (not stop)
+                               {
+                                   ++counts[n];
+                                   ThisThread::yield();
+                               }
+                           },
+                           workerPriority);
+    }
+    const auto wrapper{measure()};
+
+    for (size_t n{}; n < threadCount; ++n)
+    {
+        createRaw(n, pool, cooperativeRaw, workerPriority);
+    }
+    const auto raw{measure()};
+
+    compare("cooperativeScheduling", wrapper, raw, "switches/s");
+}
+
+// the lowest priority thread resumes the one above it, which resumes the one above it and so on. Each thread suspends
+// itself after resuming the next, so control comes back down the chain.
+void preemptiveRaw(const Ulong n)
+{
+    while (true)
+    {
+        if (n < threadCount - 1)
+        {
+            Native::tx_thread_suspend(std::addressof(rawThreads[n]));
+        }
+
+        ++counts[n];
+        if (n > 0)
+        {
+            Native::tx_thread_resume(std::addressof(rawThreads[n - 1]));
+        }
+    }
+}
+
+void preemptiveScheduling(Benchmark::Pool &pool)
+{
+    for (size_t n{}; n < threadCount; ++n)
+    {
+        runners[n].emplace("preemptive", pool,
+                           [n]() {
+                               while (true)
+                               {
+                                   if (n < threadCount - 1)
+                                   {
+                                       runners[n]->suspend();
+                                   }
+
+                                   ++counts[n];
+                                   if (n > 0)
+                                   {
+                                       runners[n - 1]->resume();
+                                   }
+                               }
+                           },
+                           Uint(workerPriority + n));
+    }
+    const auto wrapper{measure()};
+
+    for (size_t n{}; n < threadCount; ++n)
+    {
+        createRaw(n, pool, preemptiveRaw, Uint(workerPriority + n));
+    }
+    const auto raw{measure()};
+
+    compare("preemptiveScheduling", wrapper, raw, "switches/s");
+}
+
+// the handler puts a semaphore that the thread then gets. release() puts with tx_semaphore_ceiling_put and acquire() gets
+// with tx_semaphore_get, so the native side calls the same two services and the difference is only the wrapper layer.
+void interruptProcessing()
+{
+    CountingSemaphore<> semaphore{"interrupt"};
+    auto handler = [&semaphore]() { semaphore.release(); };
+    const auto wrapper{Benchmark::iterationsFor(period, [&]() {
+        handler();
+        semaphore.acquire();
+    })};
+
+    Native::tx_semaphore_create(std::addressof(rawSemaphore), const_cast<char *>("interrupt"), 0);
+    auto rawHandler = []() { Native::tx_semaphore_ceiling_put(std::addressof(rawSemaphore), std::numeric_limits<Ulong>::max()); };
+    const auto raw{Benchmark::iterationsFor(period, [&]() {
+        rawHandler();
+        Native::tx_semaphore_get(std::addressof(rawSemaphore), TX_WAIT_FOREVER);
+    })};
+    Native::tx_semaphore_delete(std::addressof(rawSemaphore));
+
+    compare("interruptProcessing", wrapper, raw, "interrupts/s");
+}
+
+// the handler resumes a thread of higher priority than the interrupted one, which counts and suspends itself.
+void interruptPreemptionRaw(const Ulong n)
+{
+    while (true)
+    {
+        if (n == 0)
+        {
+            Native::tx_thread_suspend(std::addressof(rawThreads[0]));
+            ++counts[0];
+        }
+        else
+        {
+            Native::tx_thread_resume(std::addressof(rawThreads[0]));
+        }
+    }
+}
+
+void interruptPreemption(Benchmark::Pool &pool)
+{
+    runners[0].emplace("preempting", pool,
+                       []() {
+                           while (true)
+                           {
+                               runners[0]->suspend();
+                               ++counts[0];
+                           }
+                       },
+                       workerPriority);
+    runners[1].emplace("interrupted", pool,
+                       []() {
+                           while (true)
+                           {
+                               runners[0]->resume();
+                           }
+                       },
+                       workerPriority + 1);
+    const auto wrapper{measure()};
+
+    createRaw(0, pool, interruptPreemptionRaw, workerPriority);
+    createRaw(1, pool, interruptPreemptionRaw, workerPriority + 1);
+    const auto raw{measure()};
+
+    compare("interruptPreemption", wrapper, raw, "preemptions/s");
+}
+
+// a thread sends a 16 byte message to a queue and receives it back.
+void messageProcessing(Benchmark::Pool &pool)
+{
+    Queue<Message, Benchmark::Pool> queue{"message", pool, rawQueueStorage.size()};
+    Message message{1, 2, 3, 4};
+    const auto wrapper{Benchmark::iterationsFor(period, [&]() {
+        queue.send(message);
+        auto [error, received]{queue.receive()};
+        message = received;
+    })};
+
+    Native::tx_queue_create(std::addressof(rawQueue), const_cast<char *>("message"), TX_4_ULONG, rawQueueStorage.data(), sizeof(rawQueueStorage));
+    const auto raw{Benchmark::iterationsFor(period, [&]() {
+        Native::tx_queue_send(std::addressof(rawQueue), message.data(), TX_WAIT_FOREVER);
+        Native::tx_queue_receive(std::addressof(rawQueue), message.data(), TX_WAIT_FOREVER);
+    })};
+    Native::tx_queue_delete(std::addressof(rawQueue));
+
+    compare("messageProcessing", wrapper, raw, "send-receive/s");
+}
+
+// a thread gets and puts a semaphore that no other thread uses. Both sides get with tx_semaphore_get and put with
+// tx_semaphore_ceiling_put, which is what tryAcquire() and release() call.
+void synchronisation()
+{
+    CountingSemaphore<> semaphore{"synchronisation", 1};
+    const auto wrapper{Benchmark::iterationsFor(period, [&]() {
+        semaphore.tryAcquire();
+        semaphore.release();
+    })};
+
+    Native::tx_semaphore_create(std::addressof(rawSemaphore), const_cast<char *>("synchronisation"), 1);
+    const auto raw{Benchmark::iterationsFor(period, []() {
+        Native::tx_semaphore_get(std::addressof(rawSemaphore), TX_NO_WAIT);
+        Native::tx_semaphore_ceiling_put(std::addressof(rawSemaphore), std::numeric_limits<Ulong>::max());
+    })};
+    Native::tx_semaphore_delete(std::addressof(rawSemaphore));
+
+    compare("synchronisation", wrapper, raw, "get-put/s");
+}
+
+void mutexProcessing()
+{
+    Mutex mutex{"mutex"};
+    const auto wrapper{Benchmark::iterationsFor(period, [&]() {
+        mutex.lock();
+        mutex.unlock();
+    })};
+
+    Native::tx_mutex_create(std::addressof(rawMutex), const_cast<char *>("mutex"), TX_INHERIT);
+    const auto raw{Benchmark::iterationsFor(period, []() {
+        Native::tx_mutex_get(std::addressof(rawMutex), TX_WAIT_FOREVER);
+        Native::tx_mutex_put(std::addressof(rawMutex));
+    })};
+    Native::tx_mutex_delete(std::addressof(rawMutex));
+
+    compare("mutexProcessing", wrapper, raw, "lock-unlock/s");
+}
+
+void eventFlagsProcessing()
+{
+    EventFlags eventFlags{"eventFlags"};
+    const auto wrapper{Benchmark::iterationsFor(period, [&]() {
+        eventFlags.set(1);
+        eventFlags.waitAny(1);
+    })};
+
+    Native::tx_event_flags_create(std::addressof(rawEventFlags), const_cast<char *>("eventFlags"));
+    const auto raw{Benchmark::iterationsFor(period, []() {
+        Ulong actualFlags{};
+        Native::tx_event_flags_set(std::addressof(rawEventFlags), 1, TX_OR);
+        Native::tx_event_flags_get(std::addressof(rawEventFlags), 1, TX_OR_CLEAR, std::addressof(actualFlags), TX_WAIT_FOREVER);
+    })};
+    Native::tx_event_flags_delete(std::addressof(rawEventFlags));
+
+    compare("eventFlagsProcessing", wrapper, raw, "set-wait/s");
+}
+
+// a thread allocates a 128 byte block and releases it.
+void memoryAllocation()
+{
+    static Blocks blocks{"blocks"};
+    const auto blockWrapper{Benchmark::iterationsFor(period, []() {
+        auto [error, blockPtr]{blocks.allocate()};
+        Blocks::release(blockPtr);
+    })};
+
+    Native::tx_block_pool_create(std::addressof(rawBlockPool), const_cast<char *>("blocks"), blockSize, rawBlockPoolStorage.data(), sizeof(rawBlockPoolStorage));
+    const auto blockRaw{Benchmark::iterationsFor(period, []() {
+        void *blockPtr{};
+        Native::tx_block_allocate(std::addressof(rawBlockPool), std::addressof(blockPtr), TX_NO_WAIT);
+        Native::tx_block_release(blockPtr);
+    })};
+    Native::tx_block_pool_delete(std::addressof(rawBlockPool));
+
+    compare("blockPoolAllocation", blockWrapper, blockRaw, "allocate-release/s");
+
+    static Bytes bytes{"bytes"};
+    const auto byteWrapper{Benchmark::iterationsFor(period, []() { Allocation<Bytes> allocation{bytes, blockSize}; })};
+
+    Native::tx_byte_pool_create(std::addressof(rawBytePool), const_cast<char *>("bytes"), rawBytePoolStorage.data(), sizeof(rawBytePoolStorage));
+    const auto byteRaw{Benchmark::iterationsFor(period, []() {
+        void *memoryPtr{};
+        Native::tx_byte_allocate(std::addressof(rawBytePool), std::addressof(memoryPtr), blockSize, TX_NO_WAIT);
+        Native::tx_byte_release(memoryPtr);
+    })};
+    Native::tx_byte_pool_delete(std::addressof(rawBytePool));
+
+    compare("bytePoolAllocation", byteWrapper, byteRaw, "allocate-release/s");
+}
+
+void run(Benchmark::Pool &pool)
+{
+    cooperativeScheduling(pool);
+    preemptiveScheduling(pool);
+    interruptProcessing();
+    interruptPreemption(pool);
+    messageProcessing(pool);
+    synchronisation();
+    mutexProcessing();
+    eventFlagsProcessing();
+    memoryAllocation();
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"threadMetricBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,204 @@
+// Measures how long timers and timed waits take compared to what was requested, while CPU load from a higher priority
+// thread and load in the timer thread are swept. Interrupt load is represented by the timer thread load, as a portable
+// benchmark cannot raise interrupts. Every case prints the requested time and the min, p50, p99 and max of the measured
+// time. TickTimer::ticks() rounds up, so waits of a fraction of a tick measure up to one tick longer than requested.
+// Each case takes a few hundred samples of three or four ticks, so the whole run takes minutes.
+
+#include "benchmark.hpp"
+#include "highResClock.hpp"
+#include "histogram.hpp"
+#include "queue.hpp"
+#include "semaphore.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+using std::chrono::microseconds;
+
+constexpr Uint loadPriority{Benchmark::runnerPriority - 1};
+constexpr size_t samples{300}; // enough for p99 to differ from max
+constexpr size_t bins{64};
+constexpr microseconds tick{std::chrono::duration_cast<microseconds>(TickTimer::Duration{1})};
+constexpr microseconds requested{tick * 7 / 2}; // waits of three and a half ticks
+constexpr TickTimer::Duration timerPeriod{3};
+
+using LatencyHistogram = Histogram<bins>;
+
+enum class LoadType
+{
+    none,
+    cpu,  ///< a thread above the measuring thread, busy for part of every tick
+    timer ///< a timer callback, busy for part of every tick
+};
+
+using Load = struct
+{
+    LoadType type;
+    Ulong percent;
+    std::string_view name;
+};
+
+constexpr std::array loads{Load{LoadType::none, 0, "idle"},       Load{LoadType::cpu, 25, "cpu 25%"},     Load{LoadType::cpu, 50, "cpu 50%"},    Load{LoadType::cpu, 75, "cpu 75%"},
+                           Load{LoadType::timer, 25, "timer 25%"}, Load{LoadType::timer, 50, "timer 50%"}, Load{LoadType::timer, 75, "timer 75%"}};
+
+Ulong elapsed(const HighResClock::TimePoint start, const HighResClock::TimePoint end)
+{
+    return Ulong(std::chrono::duration_cast<microseconds>(end - start).count());
+}
+
+void busyFor(const microseconds duration)
+{
+    for (const auto end{HighResClock::now() + duration}; HighResClock::now() < end;)
+    {
+    }
+}
+
+void report(const std::string_view testCase, const Load &load, const microseconds expected, const LatencyHistogram &histogram)
+{
+    std::array<char, 48> name{};
+    auto line = [&](const std::string_view statistic, const Ulong value) {
+        std::snprintf(name.data(), name.size(), "%.*s %.*s %.*s", int(testCase.size()), testCase.data(), int(load.name.size()), load.name.data(), int(statistic.size()), statistic.data());
+        Benchmark::report("TimerAccuracy", name.data(), double(value), "us");
+    };
+
+    line("requested", Ulong(expected.count()));
+    line("min", histogram.min());
+    line("p50", histogram.percentile(50));
+    line("p99", histogram.percentile(99));
+    line("max", histogram.max());
+}
+
+/// records the intervals between expirations of a periodic timer.
+void measurePeriodic(const TickTimer::Type type, const std::string_view testCase, const Load &load)
+{
+    LatencyHistogram histogram{Ulong(tick.count() / 8)};
+    BinarySemaphore done{"done"};
+    std::optional<HighResClock::TimePoint> previous;
+    size_t count{};
+
+    TickTimer timer{"periodic", timerPeriod,
+                    [&](auto) {
+                        const auto now{HighResClock::now()};
+                        if (previous and count < samples)
+                        {
+                            histogram.insert(elapsed(*previous, now));
+                            if (++count == samples)
+                            {
+                                [[maybe_unused]] auto error{done.release()};
+                            }
+                        }
+
+                        previous = now;
+                    },
+                    type};
+
+    [[maybe_unused]] auto error{done.acquire()};
+    error = timer.deactivate();
+    report(testCase, load, std::chrono::duration_cast<microseconds>(timerPeriod), histogram);
+}
+
+/// records the time from arming a one-shot timer to its expiration.
+void measureOneShot(const Load &load)
+{
+    LatencyHistogram histogram{Ulong(tick.count() / 8)};
+    BinarySemaphore expired{"expired"};
+    HighResClock::TimePoint expiry;
+
+    TickTimer timer{"oneShot", requested,
+                    [&](auto) {
+                        expiry = HighResClock::now();
+                        [[maybe_unused]] auto error{expired.release()};
+                    },
+                    TickTimer::Type::oneShot, TickTimer::ActivationType::noActivate};
+
+    for (size_t sample{}; sample < samples; ++sample)
+    {
+        const auto start{HighResClock::now()};
+        [[maybe_unused]] auto error{timer.reset(requested, TickTimer::Type::oneShot, TickTimer::ActivationType::autoActivate)};
+        error = expired.acquire();
+        histogram.insert(elapsed(start, expiry));
+    }
+
+    report("oneShot", load, requested, histogram);
+}
+
+/// records the time a call that waits for the requested time takes.
+void measureWait(const std::string_view testCase, const Load &load, const std::function<void()> &wait)
+{
+    LatencyHistogram histogram{Ulong(tick.count() / 8)};
+    for (size_t sample{}; sample < samples; ++sample)
+    {
+        const auto start{HighResClock::now()};
+        wait();
+        histogram.insert(elapsed(start, HighResClock::now()));
+    }
+
+    report(testCase, load, requested, histogram);
+}
+
+void run(const Load &load, Benchmark::Pool &pool)
+{
+    const auto busy{tick * load.percent / 100};
+    std::atomic_bool stop{};
+
+    std::optional<Benchmark::Runner> cpuLoad;
+    if (load.type == LoadType::cpu)
+    {
+        cpuLoad.emplace("cpuLoad", pool,
+                        [&]() {
+                            while (not stop)
+                            {
+                                // the sleep ends on the next tick, so the thread is busy for the first part of every tick.
+                                busyFor(busy);
+                                ThisThread::sleepFor(TickTimer::Duration{1});
+                            }
+                        },
+                        loadPriority);
+    }
+
+    std::optional<TickTimer> timerLoad;
+    if (load.type == LoadType::timer)
+    {
+        timerLoad.emplace("timerLoad", TickTimer::Duration{1}, [busy](auto) { busyFor(busy); });
+    }
+
+    measurePeriodic(TickTimer::Type::periodic, "periodic", load);
+    measurePeriodic(TickTimer::Type::periodicImmediate, "periodicImmediate", load);
+    measureOneShot(load);
+    measureWait("sleepFor", load, []() { ThisThread::sleepFor(requested); });
+
+    BinarySemaphore semaphore{"neverReleased"};
+    measureWait("tryAcquireFor", load, [&]() { [[maybe_unused]] auto error{semaphore.tryAcquireFor(requested)}; });
+
+    Queue<Ulong, Benchmark::Pool> queue{"neverSent", pool, 1};
+    measureWait("tryReceiveFor", load, [&]() { [[maybe_unused]] auto result{queue.tryReceiveFor(requested)}; });
+
+    stop = true;
+    if (cpuLoad)
+    {
+        cpuLoad->join();
+    }
+}
+
+void run(Benchmark::Pool &pool)
+{
+    for (const auto &load : loads)
+    {
+        run(load, pool);
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"timerAccuracyBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,58 @@
+// Compares the cost of arming and disarming a timer: start and cancel of a SoftTimer on a TimerWheel loaded with
+// thousands of timers, construction and destruction of a TickTimer, and reset of a TickTimer.
+
+#include "benchmark.hpp"
+#include "timerWheel.hpp"
+#include "workQueue.hpp"
+#include <array>
+#include <chrono>
+#include <optional>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr size_t loadTimers{2000};
+
+void run(Benchmark::Pool &pool)
+{
+    WorkQueue workQueue{"timerWheel", pool, Benchmark::stackSize, workerPriority};
+    TimerWheel wheel{workQueue};
+
+    // background load spread over all levels of the wheel, none of which expires during the measurement.
+    static std::array<std::optional<SoftTimer>, loadTimers> load;
+    for (size_t timer{}; timer < loadTimers; ++timer)
+    {
+        load[timer].emplace([](SoftTimer &) {});
+        wheel.start(*load[timer], TickTimer::Duration{10 * period.count() + timer * timer});
+    }
+
+    SoftTimer softTimer{[](SoftTimer &) {}};
+    Benchmark::report("TimerWheel", "SoftTimer start cancel", double(Benchmark::iterationsFor(period, [&]() {
+                                                                        wheel.start(softTimer, 100ms);
+                                                                        wheel.cancel(softTimer);
+                                                                    })),
+                      "operations/s");
+
+    Benchmark::report("TimerWheel", "TickTimer construct destroy", double(Benchmark::iterationsFor(period, []() { TickTimer tickTimer{"tickTimer", 100ms, [](auto) {}, TickTimer::Type::oneShot}; })), "operations/s");
+
+    TickTimer tickTimer{"tickTimer", 100ms, [](auto) {}, TickTimer::Type::oneShot};
+    Benchmark::report("TimerWheel", "TickTimer reset", double(Benchmark::iterationsFor(period, [&]() { [[maybe_unused]] auto error{tickTimer.reset(100ms)}; })), "operations/s");
+
+    for (auto &timer : load)
+    {
+        timer.reset();
+    }
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"timerWheelBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,81 @@
+// Measures how late a probe timer expires while another timer has a slow callback, with the slow work run in the
+// timer callback itself and with it deferred to a WorkQueue.
+
+#include "benchmark.hpp"
+#include "highResClock.hpp"
+#include "workQueue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace
+{
+using namespace ThreadX;
+using namespace std::chrono_literals;
+
+constexpr TickTimer::Duration period{TickTimer::ticks(1s)};
+constexpr Uint workerPriority{Benchmark::runnerPriority + 1};
+constexpr TickTimer::Duration slowInterval{10};
+constexpr TickTimer::Duration slowCost{3};
+
+void slowWork()
+{
+    for (const auto end{TickTimer::now() + slowCost}; TickTimer::now() < end;)
+    {
+    }
+}
+
+void run(const bool deferred, Benchmark::Pool &pool)
+{
+    WorkQueue workQueue{"workQueue", pool, Benchmark::stackSize, workerPriority};
+    WorkItem slowItem{[](WorkItem &) { slowWork(); }};
+
+    // the probe expires every tick, so the part of a gap beyond one tick is timer thread latency.
+    std::atomic<HighResClock::rep> maxGap{};
+    auto previous{HighResClock::now()};
+    TickTimer probe{"probe", TickTimer::Duration{1}, [&](auto) {
+                        const auto now{HighResClock::now()};
+                        maxGap = std::max(maxGap.load(), HighResClock::rep(std::chrono::duration_cast<std::chrono::microseconds>(now - std::exchange(previous, now)).count()));
+                    }};
+
+    TickTimer slow{"slow", slowInterval, [&](auto) {
+                       if (deferred)
+                       {
+                           workQueue.post(slowItem);
+                       }
+                       else
+                       {
+                           slowWork();
+                       }
+                   }};
+
+    ThisThread::sleepFor(period);
+    [[maybe_unused]] auto error{slow.deactivate()};
+    error = probe.deactivate();
+
+    // slowItem must not be running when it goes out of scope.
+    ThisThread::sleepFor(slowCost + TickTimer::Duration{1});
+
+    const auto name{deferred ? std::string_view{"deferred"} : std::string_view{"in callback"}};
+    const auto tickPeriod{std::chrono::duration_cast<std::chrono::microseconds>(TickTimer::Duration{1}).count()};
+    Benchmark::report("WorkQueue", name, double(maxGap) - double(tickPeriod), "us late");
+    if (deferred)
+    {
+        Benchmark::report("WorkQueue", "work latency", double(workQueue.metrics().maxLatency), "us");
+    }
+}
+
+void run(Benchmark::Pool &pool)
+{
+    run(false, pool);
+    run(true, pool);
+
+    Benchmark::finish();
+}
+} // namespace
+
+void ThreadX::application()
+{
+    static Benchmark::Pool pool{"benchmark"};
+    static Benchmark::Runner runner{"workQueueBenchmark", pool, []() { run(pool); }};
+}
@@ -0,0 +1,167 @@
+#include "conditionVariable.hpp"
+#include "kernel.hpp"
+#include <cassert>
+#include <memory>
+#include <utility>
+
+namespace ThreadX
+{
+ConditionVariableBase::Waiter::Waiter() : m_signalPtr{std::addressof(m_ownSignal)}
+{
+    bool create{true};
+    {
+        Kernel::CriticalSection cs;
+        if (m_freeSignals)
+        {
+            m_signalPtr = std::addressof(std::exchange(m_freeSignals, m_freeSignals->next)->semaphore);
+            create = false;
+        }
+        else if (m_signalsCreated < m_signals.size())
+        {
+            m_signalPtr = std::addressof(m_signals[m_signalsCreated++].semaphore);
+        }
+    }
+
+    if (create)
+    {
+        [[maybe_unused]] Error error{Native::tx_semaphore_create(m_signalPtr, const_cast<char *>("conditionVariable"), 0)};
+        assert(error == Error::success);
+    }
+}
+
+ConditionVariableBase::Waiter::~Waiter()
+{
+    if (m_signalPtr == std::addressof(m_ownSignal))
+    {
+        [[maybe_unused]] Error error{Native::tx_semaphore_delete(m_signalPtr)};
+        assert(error == Error::success);
+        return;
+    }
+
+    // the semaphore is the first member of its pool entry.
+    auto &signal{*reinterpret_cast<PooledSignal *>(m_signalPtr)};
+    Kernel::CriticalSection cs;
+    signal.next = std::exchange(m_freeSignals, std::addressof(signal));
+}
+
+void ConditionVariableBase::notify_one()
+{
+    Waiter *waiterPtr{};
+    {
+        Kernel::CriticalSection cs;
+        if (waiterPtr = m_head; waiterPtr)
+        {
+            m_head = waiterPtr->m_next;
+            m_tail = m_head ? m_tail : nullptr;
+        }
+    }
+
+    if (waiterPtr)
+    {
+        [[maybe_unused]] Error error{Native::tx_semaphore_put(waiterPtr->m_signalPtr)};
+        assert(error == Error::success);
+    }
+}
+
+void ConditionVariableBase::notify_all()
+{
+    Waiter *waiterPtr{};
+    {
+        Kernel::CriticalSection cs;
+        waiterPtr = std::exchange(m_head, nullptr);
+        m_tail = nullptr;
+    }
+
+    // a woken waiter may return and destroy its node, so the next one is read first.
+    while (waiterPtr)
+    {
+        auto nextPtr{waiterPtr->m_next};
+        [[maybe_unused]] Error error{Native::tx_semaphore_put(waiterPtr->m_signalPtr)};
+        assert(error == Error::success);
+        waiterPtr = nextPtr;
+    }
+}
+
+void ConditionVariableBase::enqueue(Waiter &waiter)
+{
+    Kernel::CriticalSection cs;
+    waiter.m_next = nullptr;
+    if (m_tail)
+    {
+        m_tail->m_next = std::addressof(waiter);
+    }
+    else
+    {
+        m_head = std::addressof(waiter);
+    }
+
+    m_tail = std::addressof(waiter);
+}
+
+std::cv_status ConditionVariableBase::wait(Waiter &waiter, const Ulong ticks)
+{
+    if (Error{Native::tx_semaphore_get(waiter.m_signalPtr, ticks)} == Error::success)
+    {
+        return std::cv_status::no_timeout;
+    }
+
+    if (remove(waiter))
+    {
+        return std::cv_status::timeout;
+    }
+
+    // a notifier has taken the node off the list, and the node must live until its release is done.
+    [[maybe_unused]] Error error{Native::tx_semaphore_get(waiter.m_signalPtr, TX_WAIT_FOREVER)};
+    assert(error == Error::success);
+    return std::cv_status::no_timeout;
+}
+
+bool ConditionVariableBase::remove(Waiter &waiter)
+{
+    Kernel::CriticalSection cs;
+    Waiter *previousPtr{};
+    for (auto waiterPtr{m_head}; waiterPtr; previousPtr = std::exchange(waiterPtr, waiterPtr->m_next))
+    {
+        if (waiterPtr == std::addressof(waiter))
+        {
+            (previousPtr ? previousPtr->m_next : m_head) = waiter.m_next;
+            m_tail = m_tail == waiterPtr ? previousPtr : m_tail;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ConditionVariable::wait(UniqueLock &lock)
+{
+    waitFor(lock, TickTimer::waitForever.count());
+}
+
+std::cv_status ConditionVariable::waitFor(UniqueLock &lock, const Ulong ticks)
+{
+    assert(lock.owns_lock());
+    auto &mutex{*lock.mutex()};
+    const auto ownershipCount{mutex.ownershipCount()};
+
+    Waiter waiter;
+    enqueue(waiter);
+
+    // every recursive ownership is given up and taken back, while the UniqueLock keeps owning the mutex as far as it knows.
+    for (auto count{ownershipCount}; count > 0; --count)
+    {
+        [[maybe_unused]] auto error{mutex.unlock()};
+        assert(error == Error::success);
+    }
+
+    const auto status{ConditionVariableBase::wait(waiter, ticks)};
+
+    for (auto count{ownershipCount}; count > 0; --count)
+    {
+        [[maybe_unused]] auto error{mutex.lock()};
+        assert(error == Error::success);
+    }
+
+    return status;
+}
+} // namespace ThreadX
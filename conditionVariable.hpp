@@ -0,0 +1,212 @@
+#pragma once
+
+#include "mutex.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <array>
+#include <condition_variable>
+#include <string_view>
+
+#ifndef THREADX_CONDITION_VARIABLE_SIGNALS
+#define THREADX_CONDITION_VARIABLE_SIGNALS 8
+#endif
+
+namespace ThreadX
+{
+/// Waiter list shared by ConditionVariable and ConditionVariableAny. Every waiting thread queues a node with its own
+/// semaphore on its stack, so a notification reaches exactly the threads that were waiting when it was made and is
+/// never lost or left over for later waiters. Waiters are notified in FIFO order.
+/// The semaphores come from a pool of THREADX_CONDITION_VARIABLE_SIGNALS shared by all condition variables. Each one is
+/// created on first use and then reused, so a wait does not create and delete a kernel object. A waiter beyond the pool
+/// creates its own semaphore.
+class ConditionVariableBase
+{
+  public:
+    ConditionVariableBase(const ConditionVariableBase &) = delete;
+    ConditionVariableBase &operator=(const ConditionVariableBase &) = delete;
+
+    /// wakes the longest waiting thread, if any.
+    void notify_one();
+
+    /// wakes all waiting threads. The list is taken in one step, so threads that start waiting meanwhile are not woken.
+    void notify_all();
+
+  protected:
+    class Waiter
+    {
+      public:
+        Waiter();
+
+        /// gives the semaphore back to the pool, where it has no count left.
+        ~Waiter();
+
+        Waiter(const Waiter &) = delete;
+        Waiter &operator=(const Waiter &) = delete;
+
+      private:
+        friend class ConditionVariableBase;
+
+        Native::TX_SEMAPHORE *m_signalPtr;
+        Native::TX_SEMAPHORE m_ownSignal{}; // when all of the pool is in use
+        Waiter *m_next{};
+    };
+
+    ConditionVariableBase() = default;
+    ~ConditionVariableBase() = default;
+
+    /// queues the waiter. Must be called before the lock is released, so that no notification is missed.
+    void enqueue(Waiter &waiter);
+
+    /// blocks until the waiter is notified or the timeout expires. The waiter is no longer queued on return.
+    std::cv_status wait(Waiter &waiter, const Ulong ticks);
+
+  private:
+    struct PooledSignal
+    {
+        Native::TX_SEMAPHORE semaphore;
+        PooledSignal *next;
+    };
+
+    bool remove(Waiter &waiter);
+
+    static inline std::array<PooledSignal, THREADX_CONDITION_VARIABLE_SIGNALS> m_signals{};
+    static inline PooledSignal *m_freeSignals{};
+    static inline size_t m_signalsCreated{};
+
+    Waiter *m_head{};
+    Waiter *m_tail{};
+};
+
+/// Condition variable for Mutex. The mutex may be locked recursively, it is released and reacquired as many times as it
+/// is locked by the waiting thread.
+class ConditionVariable : public ConditionVariableBase
+{
+  public:
+    ConditionVariable() = default;
+
+    void wait(UniqueLock &lock);
+
+    template <class Predicate> void wait(UniqueLock &lock, Predicate stopWaiting);
+
+    template <class Clock, typename Duration> std::cv_status wait_until(UniqueLock &lock, const std::chrono::time_point<Clock, Duration> &time);
+
+    template <class Clock, typename Duration, class Predicate> bool wait_until(UniqueLock &lock, const std::chrono::time_point<Clock, Duration> &time, Predicate stopWaiting);
+
+    template <typename Rep, typename Period> std::cv_status wait_for(UniqueLock &lock, const std::chrono::duration<Rep, Period> &duration);
+
+    template <typename Rep, typename Period, class Predicate> bool wait_for(UniqueLock &lock, const std::chrono::duration<Rep, Period> &duration, Predicate stopWaiting);
+
+  private:
+    std::cv_status waitFor(UniqueLock &lock, const Ulong ticks);
+};
+
+/// Condition variable for any lock with lock() and unlock(), such as std::unique_lock over FastMutex or SharedMutex.
+/// The lock is released once, so a recursively locked mutex must use ConditionVariable.
+class ConditionVariableAny : public ConditionVariableBase
+{
+  public:
+    ConditionVariableAny() = default;
+
+    template <class Lock> void wait(Lock &lock);
+
+    template <class Lock, class Predicate> void wait(Lock &lock, Predicate stopWaiting);
+
+    template <class Lock, class Clock, typename Duration> std::cv_status wait_until(Lock &lock, const std::chrono::time_point<Clock, Duration> &time);
+
+    template <class Lock, class Clock, typename Duration, class Predicate> bool wait_until(Lock &lock, const std::chrono::time_point<Clock, Duration> &time, Predicate stopWaiting);
+
+    template <class Lock, typename Rep, typename Period> std::cv_status wait_for(Lock &lock, const std::chrono::duration<Rep, Period> &duration);
+
+    template <class Lock, typename Rep, typename Period, class Predicate> bool wait_for(Lock &lock, const std::chrono::duration<Rep, Period> &duration, Predicate stopWaiting);
+
+  private:
+    template <class Lock> std::cv_status waitFor(Lock &lock, const Ulong ticks);
+};
+
+template <class Predicate> void ConditionVariable::wait(UniqueLock &lock, Predicate stopWaiting)
+{
+    while (not stopWaiting())
+    {
+        wait(lock);
+    }
+}
+
+template <class Clock, typename Duration> std::cv_status ConditionVariable::wait_until(UniqueLock &lock, const std::chrono::time_point<Clock, Duration> &time)
+{
+    return wait_for(lock, time - Clock::now());
+}
+
+template <class Clock, typename Duration, class Predicate> bool ConditionVariable::wait_until(UniqueLock &lock, const std::chrono::time_point<Clock, Duration> &time, Predicate stopWaiting)
+{
+    while (not stopWaiting())
+    {
+        if (wait_until(lock, time) == std::cv_status::timeout)
+        {
+            return stopWaiting();
+        }
+    }
+
+    return true;
+}
+
+template <typename Rep, typename Period> std::cv_status ConditionVariable::wait_for(UniqueLock &lock, const std::chrono::duration<Rep, Period> &duration)
+{
+    return waitFor(lock, TickTimer::ticks(duration));
+}
+
+template <typename Rep, typename Period, class Predicate> bool ConditionVariable::wait_for(UniqueLock &lock, const std::chrono::duration<Rep, Period> &duration, Predicate stopWaiting)
+{
+    return wait_until(lock, TickTimer::now() + TickTimer::Duration{TickTimer::ticks(duration)}, stopWaiting);
+}
+
+template <class Lock> void ConditionVariableAny::wait(Lock &lock)
+{
+    waitFor(lock, TickTimer::waitForever.count());
+}
+
+template <class Lock, class Predicate> void ConditionVariableAny::wait(Lock &lock, Predicate stopWaiting)
+{
+    while (not stopWaiting())
+    {
+        wait(lock);
+    }
+}
+
+template <class Lock, class Clock, typename Duration> std::cv_status ConditionVariableAny::wait_until(Lock &lock, const std::chrono::time_point<Clock, Duration> &time)
+{
+    return wait_for(lock, time - Clock::now());
+}
+
+template <class Lock, class Clock, typename Duration, class Predicate> bool ConditionVariableAny::wait_until(Lock &lock, const std::chrono::time_point<Clock, Duration> &time, Predicate stopWaiting)
+{
+    while (not stopWaiting())
+    {
+        if (wait_until(lock, time) == std::cv_status::timeout)
+        {
+            return stopWaiting();
+        }
+    }
+
+    return true;
+}
+
+template <class Lock, typename Rep, typename Period> std::cv_status ConditionVariableAny::wait_for(Lock &lock, const std::chrono::duration<Rep, Period> &duration)
+{
+    return waitFor(lock, TickTimer::ticks(duration));
+}
+
+template <class Lock, typename Rep, typename Period, class Predicate> bool ConditionVariableAny::wait_for(Lock &lock, const std::chrono::duration<Rep, Period> &duration, Predicate stopWaiting)
+{
+    return wait_until(lock, TickTimer::now() + TickTimer::Duration{TickTimer::ticks(duration)}, stopWaiting);
+}
+
+template <class Lock> std::cv_status ConditionVariableAny::waitFor(Lock &lock, const Ulong ticks)
+{
+    Waiter waiter;
+    enqueue(waiter);
+    lock.unlock();
+    const auto status{ConditionVariableBase::wait(waiter, ticks)};
+    lock.lock();
+    return status;
+}
+} // namespace ThreadX
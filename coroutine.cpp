@@ -0,0 +1,373 @@
+#include "coroutine.hpp"
+#include "kernel.hpp"
+#include <algorithm>
+
+namespace ThreadX
+{
+void CoroutineTask::promise_type::operator delete(void *const framePtr) noexcept
+{
+    [[maybe_unused]] Error error{Native::tx_block_release(framePtr)};
+    assert(error == Error::success);
+}
+
+CoroutineTask CoroutineTask::promise_type::get_return_object_on_allocation_failure() noexcept
+{
+    return CoroutineTask{Handle{}};
+}
+
+CoroutineTask CoroutineTask::promise_type::get_return_object() noexcept
+{
+    return CoroutineTask{Handle::from_promise(*this)};
+}
+
+std::suspend_always CoroutineTask::promise_type::initial_suspend() const noexcept
+{
+    return {};
+}
+
+std::suspend_never CoroutineTask::promise_type::final_suspend() const noexcept
+{
+    return {};
+}
+
+void CoroutineTask::promise_type::return_void() const noexcept
+{
+}
+
+void CoroutineTask::promise_type::unhandled_exception() const noexcept
+{
+    std::terminate();
+}
+
+CoroutineSchedulerBase &CoroutineTask::promise_type::scheduler() const
+{
+    return m_scheduler;
+}
+
+CoroutineTask::CoroutineTask(const Handle handle) : m_handle{handle}
+{
+}
+
+CoroutineTask::CoroutineTask(CoroutineTask &&task) noexcept : m_handle{std::exchange(task.m_handle, {})}
+{
+}
+
+CoroutineTask::~CoroutineTask()
+{
+    if (m_handle)
+    {
+        m_handle.destroy();
+    }
+}
+
+CoroutineTask::operator bool() const
+{
+    return bool{m_handle};
+}
+
+Awaitable::~Awaitable()
+{
+    assert(not m_awaitersHead);
+
+    // a signal that the scheduler has not handled yet is withdrawn.
+    Kernel::CriticalSection cs;
+    if (m_signalled)
+    {
+        auto *nextPtr{std::addressof(m_schedulerPtr->m_signalledHead)};
+        while (*nextPtr != this)
+        {
+            nextPtr = std::addressof((*nextPtr)->m_signalledNext);
+        }
+
+        *nextPtr = m_signalledNext;
+    }
+}
+
+AwaitableEventFlags::AwaitableEventFlags(const std::string_view name, const NotifyCallback &setNotifyCallback) : EventFlags{name, signalling(setNotifyCallback)}
+{
+}
+
+void Awaitable::signal()
+{
+    CoroutineSchedulerBase *schedulerPtr{};
+    {
+        Kernel::CriticalSection cs;
+        if (not m_schedulerPtr or m_signalled)
+        {
+            return;
+        }
+
+        schedulerPtr = m_schedulerPtr;
+        m_signalled = true;
+        m_signalledNext = std::exchange(schedulerPtr->m_signalledHead, this);
+    }
+
+    schedulerPtr->wake();
+}
+
+CoroutineAwaiter::CoroutineAwaiter(Awaitable *const awaitablePtr, const Ulong ticks) : m_awaitablePtr{awaitablePtr}, m_ticks{ticks}
+{
+}
+
+bool CoroutineAwaiter::await_ready()
+{
+    return poll() or m_ticks == TickTimer::noWait.count();
+}
+
+void CoroutineAwaiter::await_suspend(const CoroutineTask::Handle handle)
+{
+    m_handle = handle;
+    handle.promise().scheduler().wait(*this);
+}
+
+CoroutineSchedulerBase::CoroutineSchedulerBase(const std::string_view name)
+    : m_wake{name}, m_deadlineTimer{name, TickTimer::Duration{1}, [this](auto) { wake(); }, TickTimer::Type::oneShot, TickTimer::ActivationType::noActivate}
+{
+}
+
+Error CoroutineSchedulerBase::spawn(CoroutineTask &&task)
+{
+    if (not task)
+    {
+        return Error::noMemory;
+    }
+
+    auto &promise{std::exchange(task.m_handle, {}).promise()};
+    assert(std::addressof(promise.m_scheduler) == this);
+    {
+        Kernel::CriticalSection cs;
+        promise.m_next = nullptr;
+        (m_readyTail ? m_readyTail->m_next : m_readyHead) = std::addressof(promise);
+        m_readyTail = std::addressof(promise);
+    }
+
+    wake();
+    return Error::success;
+}
+
+void CoroutineSchedulerBase::wake()
+{
+    // the wake-up may already be pending, in which case the semaphore is at its ceiling.
+    [[maybe_unused]] auto error{m_wake.release()};
+}
+
+void CoroutineSchedulerBase::wait(CoroutineAwaiter &awaiter)
+{
+    // coroutines only suspend while the scheduler thread resumes them, so the awaiter and deadline lists need no locking.
+    if (awaiter.m_awaitablePtr)
+    {
+        auto &awaitable{*awaiter.m_awaitablePtr};
+        {
+            Kernel::CriticalSection cs;
+            assert(not awaitable.m_schedulerPtr or awaitable.m_schedulerPtr == this);
+            awaitable.m_schedulerPtr = this;
+        }
+
+        awaiter.m_next = nullptr;
+        (awaitable.m_awaitersTail ? awaitable.m_awaitersTail->m_next : awaitable.m_awaitersHead) = std::addressof(awaiter);
+        awaitable.m_awaitersTail = std::addressof(awaiter);
+
+        // a signal between the failed poll in await_ready() and here found no scheduler, so the awaiter is tried once more.
+        awaitable.signal();
+    }
+
+    if (awaiter.m_ticks != TickTimer::waitForever.count())
+    {
+        awaiter.m_deadline = TickTimer::now().time_since_epoch().count() + awaiter.m_ticks;
+        auto *nextPtr{std::addressof(m_deadlinesHead)};
+        while (*nextPtr and Long((*nextPtr)->m_deadline - awaiter.m_deadline) <= 0)
+        {
+            nextPtr = std::addressof((*nextPtr)->m_deadlineNext);
+        }
+
+        awaiter.m_deadlineNext = std::exchange(*nextPtr, std::addressof(awaiter));
+    }
+}
+
+void CoroutineSchedulerBase::remove(CoroutineAwaiter &awaiter)
+{
+    if (awaiter.m_awaitablePtr)
+    {
+        auto &awaitable{*awaiter.m_awaitablePtr};
+        CoroutineAwaiter *previousPtr{};
+        auto *nextPtr{std::addressof(awaitable.m_awaitersHead)};
+        while (*nextPtr != std::addressof(awaiter))
+        {
+            previousPtr = *nextPtr;
+            nextPtr = std::addressof(previousPtr->m_next);
+        }
+
+        *nextPtr = awaiter.m_next;
+        if (awaitable.m_awaitersTail == std::addressof(awaiter))
+        {
+            awaitable.m_awaitersTail = previousPtr;
+        }
+
+        release(awaitable);
+    }
+
+    if (awaiter.m_ticks != TickTimer::waitForever.count())
+    {
+        auto *nextPtr{std::addressof(m_deadlinesHead)};
+        while (*nextPtr != std::addressof(awaiter))
+        {
+            nextPtr = std::addressof((*nextPtr)->m_deadlineNext);
+        }
+
+        *nextPtr = awaiter.m_deadlineNext;
+    }
+}
+
+void CoroutineSchedulerBase::release(Awaitable &awaitable)
+{
+    // another scheduler may wait on the awaitable once this one has nothing of it left.
+    Kernel::CriticalSection cs;
+    if (not awaitable.m_awaitersHead and not awaitable.m_signalled)
+    {
+        awaitable.m_schedulerPtr = nullptr;
+    }
+}
+
+void CoroutineSchedulerBase::run()
+{
+    while (true)
+    {
+        resumeReady();
+        resumeSignalled();
+        resumeExpired();
+        armDeadlineTimer();
+
+        // spawn(), the signals of awaitables and the deadline timer wake the scheduler up, so it does not poll.
+        [[maybe_unused]] auto error{m_wake.acquire()};
+    }
+}
+
+void CoroutineSchedulerBase::resumeReady()
+{
+    CoroutineTask::promise_type *promisePtr{};
+    {
+        Kernel::CriticalSection cs;
+        promisePtr = std::exchange(m_readyHead, nullptr);
+        m_readyTail = nullptr;
+    }
+
+    // a coroutine that completes frees its frame, so the next one is read first.
+    while (promisePtr)
+    {
+        auto nextPtr{promisePtr->m_next};
+        CoroutineTask::Handle::from_promise(*promisePtr).resume();
+        promisePtr = nextPtr;
+    }
+}
+
+void CoroutineSchedulerBase::resumeSignalled()
+{
+    // a resumed coroutine may destroy an awaitable, so all of them are done with before the first is resumed.
+    CoroutineAwaiter *readyHead{};
+    CoroutineAwaiter **readyTailPtr{std::addressof(readyHead)};
+    while (true)
+    {
+        Awaitable *awaitablePtr{};
+        {
+            // a signal from now on queues the awaitable again, as the tries below may miss it.
+            Kernel::CriticalSection cs;
+            if (awaitablePtr = m_signalledHead; not awaitablePtr)
+            {
+                break;
+            }
+
+            m_signalledHead = awaitablePtr->m_signalledNext;
+            awaitablePtr->m_signalled = false;
+        }
+
+        // waiters are tried in FIFO order, and the first that fails keeps the later ones waiting.
+        auto &awaitable{*awaitablePtr};
+        while (awaitable.m_awaitersHead and awaitable.m_awaitersHead->poll())
+        {
+            auto &awaiter{*awaitable.m_awaitersHead};
+            remove(awaiter);
+            awaiter.m_next = nullptr;
+            *readyTailPtr = std::addressof(awaiter);
+            readyTailPtr = std::addressof(awaiter.m_next);
+        }
+
+        release(awaitable);
+    }
+
+    // a coroutine that completes frees its frame, so the next one is read first.
+    while (readyHead)
+    {
+        auto &awaiter{*readyHead};
+        readyHead = awaiter.m_next;
+        awaiter.m_handle.resume();
+    }
+}
+
+void CoroutineSchedulerBase::resumeExpired()
+{
+    const auto now{TickTimer::now().time_since_epoch().count()};
+    while (m_deadlinesHead and Long(m_deadlinesHead->m_deadline - now) <= 0)
+    {
+        // the last try decides what await_resume() returns.
+        auto &awaiter{*m_deadlinesHead};
+        awaiter.poll();
+        remove(awaiter);
+        awaiter.m_handle.resume();
+    }
+}
+
+void CoroutineSchedulerBase::armDeadlineTimer()
+{
+    if (not m_deadlinesHead)
+    {
+        if (std::exchange(m_deadlineArmed, false))
+        {
+            [[maybe_unused]] Error error{m_deadlineTimer.deactivate()};
+            assert(error == Error::success);
+        }
+
+        return;
+    }
+
+    if (m_deadlineArmed and m_armedDeadline == m_deadlinesHead->m_deadline)
+    {
+        return;
+    }
+
+    // one timer for the earliest deadline, it is re-armed when that coroutine is resumed.
+    const Long remaining{Long(m_deadlinesHead->m_deadline - TickTimer::now().time_since_epoch().count())};
+    [[maybe_unused]] Error error{m_deadlineTimer.reset(TickTimer::Duration{Ulong(std::max(remaining, Long{1}))}, TickTimer::ActivationType::autoActivate)};
+    assert(error == Error::success);
+    m_armedDeadline = m_deadlinesHead->m_deadline;
+    m_deadlineArmed = true;
+}
+
+EventFlagsAwaiter::EventFlagsAwaiter(AwaitableEventFlags &eventFlags, const EventFlags::Bitmask &bitMask, const bool all, const EventFlags::Option option, const Ulong ticks)
+    : CoroutineAwaiter{std::addressof(eventFlags), ticks}, m_eventFlags{eventFlags}, m_bitMask{bitMask}, m_all{all}, m_option{option}
+{
+}
+
+EventFlags::BitmaskPair EventFlagsAwaiter::await_resume() const
+{
+    return m_result;
+}
+
+bool EventFlagsAwaiter::poll()
+{
+    m_result = m_all ? m_eventFlags.waitAllFor(m_bitMask, TickTimer::noWait, m_option) : m_eventFlags.waitAnyFor(m_bitMask, TickTimer::noWait, m_option);
+    return m_result.first == Error::success;
+}
+
+SleepAwaiter::SleepAwaiter(const Ulong ticks) : CoroutineAwaiter{nullptr, ticks}
+{
+}
+
+void SleepAwaiter::await_resume() const
+{
+}
+
+bool SleepAwaiter::poll()
+{
+    return false;
+}
+} // namespace ThreadX
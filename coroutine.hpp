@@ -0,0 +1,314 @@
+#pragma once
+
+#include "awaitable.hpp"
+#include "memoryPool.hpp"
+#include "semaphore.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace ThreadX
+{
+class CoroutineSchedulerBase;
+
+/// Return type of a coroutine run by a CoroutineScheduler. The first parameter of the coroutine must be the scheduler,
+/// whose pool the coroutine frame is allocated from. The coroutine does not start until it is passed to spawn().
+class CoroutineTask
+{
+  public:
+    class promise_type
+    {
+      public:
+        /// allocates the frame as one block of the scheduler's pool.
+        static void *operator new(const size_t size, CoroutineSchedulerBase &scheduler, const auto &...) noexcept;
+        static void operator delete(void *const framePtr) noexcept;
+
+        static CoroutineTask get_return_object_on_allocation_failure() noexcept;
+
+        explicit promise_type(CoroutineSchedulerBase &scheduler, const auto &...) noexcept;
+
+        CoroutineTask get_return_object() noexcept;
+        std::suspend_always initial_suspend() const noexcept;
+        std::suspend_never final_suspend() const noexcept;
+        void return_void() const noexcept;
+        [[noreturn]] void unhandled_exception() const noexcept;
+
+        CoroutineSchedulerBase &scheduler() const;
+
+      private:
+        friend class CoroutineSchedulerBase;
+
+        CoroutineSchedulerBase &m_scheduler;
+        promise_type *m_next{};
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoroutineTask(CoroutineTask &&task) noexcept;
+    CoroutineTask &operator=(CoroutineTask &&) = delete;
+
+    /// destroys the coroutine if it was never spawned.
+    ~CoroutineTask();
+
+    /// \return false if the frame could not be allocated
+    explicit operator bool() const;
+
+  private:
+    friend class CoroutineSchedulerBase;
+
+    explicit CoroutineTask(const Handle handle);
+
+    Handle m_handle;
+};
+
+/// Base of the objects that coroutines co_await. A waiting coroutine is resumed when the Awaitable it waits on signals
+/// and its operation then succeeds, or when its timeout expires.
+class CoroutineAwaiter
+{
+  public:
+    bool await_ready();
+    void await_suspend(const CoroutineTask::Handle handle);
+
+  protected:
+    /// \param awaitablePtr object that signals when the operation may succeed, nullptr to wait for the timeout only
+    explicit CoroutineAwaiter(Awaitable *const awaitablePtr, const Ulong ticks);
+    ~CoroutineAwaiter() = default;
+
+  private:
+    friend class CoroutineSchedulerBase;
+
+    /// tries the operation without waiting.
+    /// \return true if it succeeded
+    virtual bool poll() = 0;
+
+    Awaitable *const m_awaitablePtr;
+    const Ulong m_ticks;
+    Ulong m_deadline{};
+    std::coroutine_handle<> m_handle;
+    CoroutineAwaiter *m_next{};         // waiting on the same awaitable, then ready to resume
+    CoroutineAwaiter *m_deadlineNext{}; // waiting with a timeout, by deadline
+};
+
+/// Part of CoroutineScheduler that does not depend on the pool.
+class CoroutineSchedulerBase
+{
+  public:
+    using Awaiter = CoroutineAwaiter;
+
+    CoroutineSchedulerBase(const CoroutineSchedulerBase &) = delete;
+    CoroutineSchedulerBase &operator=(const CoroutineSchedulerBase &) = delete;
+
+    /// makes a coroutine ready to run. May be called from any thread.
+    /// \return Error::noMemory if the task has no frame
+    Error spawn(CoroutineTask &&task);
+
+    /// runs the coroutines on the calling thread. It never returns.
+    [[noreturn]] void run();
+
+  protected:
+    explicit CoroutineSchedulerBase(const std::string_view name);
+    ~CoroutineSchedulerBase() = default;
+
+  private:
+    friend class CoroutineTask::promise_type;
+    friend class CoroutineAwaiter;
+    friend class Awaitable;
+
+    /// \return a block of at least size bytes, nullptr if there is none
+    virtual void *allocateFrame(const size_t size) = 0;
+
+    /// makes run() go through its lists. May be called from ISRs.
+    void wake();
+    void wait(CoroutineAwaiter &awaiter);
+    void remove(CoroutineAwaiter &awaiter);
+    void release(Awaitable &awaitable);
+
+    void resumeReady();
+    void resumeSignalled();
+    void resumeExpired();
+    void armDeadlineTimer();
+
+    CoroutineTask::promise_type *m_readyHead{}; // spawned coroutines, shared with other threads
+    CoroutineTask::promise_type *m_readyTail{};
+    Awaitable *m_signalledHead{};           // shared with notify callbacks and ISRs
+    CoroutineAwaiter *m_deadlinesHead{};    // earliest first, only used by the scheduler thread
+    Ulong m_armedDeadline{};
+    bool m_deadlineArmed{};
+    BinarySemaphore m_wake;
+    TickTimer m_deadlineTimer;
+};
+
+/// Runs many coroutines on one thread, the thread that calls run(). Coroutine frames take a block of a BlockPool each
+/// instead of a thread stack, so the block size must fit the largest frame.
+/// \tparam Pool BlockPool
+template <class Pool> class CoroutineScheduler : public CoroutineSchedulerBase
+{
+    static_assert(std::is_base_of_v<BlockPoolBase, Pool>);
+
+  public:
+    explicit CoroutineScheduler(Pool &pool, const std::string_view name = "coroutineScheduler");
+
+  private:
+    void *allocateFrame(const size_t size) final;
+
+    Pool &m_pool;
+};
+
+template <class Msg, class Pool> class QueueAwaiter : public CoroutineAwaiter
+{
+  public:
+    explicit QueueAwaiter(AwaitableQueue<Msg, Pool> &queue, const Ulong ticks);
+
+    /// \return error and message, Error::queueEmpty on timeout
+    auto await_resume() const;
+
+  private:
+    bool poll() final;
+
+    AwaitableQueue<Msg, Pool> &m_queue;
+    typename Queue<Msg, Pool>::MsgPair m_result{Error::queueEmpty, Msg{}};
+};
+
+template <class Semaphore> class SemaphoreAwaiter : public CoroutineAwaiter
+{
+  public:
+    explicit SemaphoreAwaiter(Semaphore &semaphore, const Ulong ticks);
+
+    /// \return Error::noInstance on timeout
+    Error await_resume() const;
+
+  private:
+    bool poll() final;
+
+    Semaphore &m_semaphore;
+    Error m_error{Error::noInstance};
+};
+
+class EventFlagsAwaiter : public CoroutineAwaiter
+{
+  public:
+    explicit EventFlagsAwaiter(AwaitableEventFlags &eventFlags, const EventFlags::Bitmask &bitMask, const bool all, const EventFlags::Option option, const Ulong ticks);
+
+    /// \return error and actual flags, Error::noEvents on timeout
+    EventFlags::BitmaskPair await_resume() const;
+
+  private:
+    bool poll() final;
+
+    AwaitableEventFlags &m_eventFlags;
+    const EventFlags::Bitmask m_bitMask;
+    const bool m_all;
+    const EventFlags::Option m_option;
+    EventFlags::BitmaskPair m_result{Error::noEvents, {}};
+};
+
+class SleepAwaiter : public CoroutineAwaiter
+{
+  public:
+    explicit SleepAwaiter(const Ulong ticks);
+
+    void await_resume() const;
+
+  private:
+    bool poll() final;
+};
+
+template <class Pool> CoroutineScheduler<Pool>::CoroutineScheduler(Pool &pool, const std::string_view name) : CoroutineSchedulerBase{name}, m_pool{pool}
+{
+}
+
+template <class Pool> void *CoroutineScheduler<Pool>::allocateFrame(const size_t size)
+{
+    assert(size <= m_pool.blockSize());
+    if (size > m_pool.blockSize())
+    {
+        return nullptr;
+    }
+
+    auto [error, memoryPtr]{m_pool.allocate()};
+    return memoryPtr;
+}
+
+void *CoroutineTask::promise_type::operator new(const size_t size, CoroutineSchedulerBase &scheduler, const auto &...) noexcept
+{
+    return scheduler.allocateFrame(size);
+}
+
+CoroutineTask::promise_type::promise_type(CoroutineSchedulerBase &scheduler, const auto &...) noexcept : m_scheduler{scheduler}
+{
+}
+
+template <class Msg, class Pool> QueueAwaiter<Msg, Pool>::QueueAwaiter(AwaitableQueue<Msg, Pool> &queue, const Ulong ticks) : CoroutineAwaiter{std::addressof(queue), ticks}, m_queue{queue}
+{
+}
+
+template <class Msg, class Pool> auto QueueAwaiter<Msg, Pool>::await_resume() const
+{
+    return m_result;
+}
+
+template <class Msg, class Pool> bool QueueAwaiter<Msg, Pool>::poll()
+{
+    m_result = m_queue.tryReceive();
+    return m_result.first == Error::success;
+}
+
+template <class Semaphore> SemaphoreAwaiter<Semaphore>::SemaphoreAwaiter(Semaphore &semaphore, const Ulong ticks) : CoroutineAwaiter{std::addressof(semaphore), ticks}, m_semaphore{semaphore}
+{
+}
+
+template <class Semaphore> Error SemaphoreAwaiter<Semaphore>::await_resume() const
+{
+    return m_error;
+}
+
+template <class Semaphore> bool SemaphoreAwaiter<Semaphore>::poll()
+{
+    m_error = m_semaphore.tryAcquire();
+    return m_error == Error::success;
+}
+} // namespace ThreadX
+
+/// Operations to co_await in a CoroutineTask, on the Awaitable variants of the objects. They return immediately if the
+/// operation succeeds without waiting, otherwise the coroutine is suspended and the other coroutines of its scheduler run.
+namespace ThreadX::Await
+{
+template <class Msg, class Pool, typename Rep = TickTimer::rep, typename Period = TickTimer::period>
+auto receive(AwaitableQueue<Msg, Pool> &queue, const std::chrono::duration<Rep, Period> &duration = TickTimer::waitForever)
+{
+    return QueueAwaiter<Msg, Pool>{queue, TickTimer::ticks(duration)};
+}
+
+template <Ulong Ceiling, typename Rep = TickTimer::rep, typename Period = TickTimer::period>
+auto acquire(AwaitableSemaphore<Ceiling> &semaphore, const std::chrono::duration<Rep, Period> &duration = TickTimer::waitForever)
+{
+    return SemaphoreAwaiter<AwaitableSemaphore<Ceiling>>{semaphore, TickTimer::ticks(duration)};
+}
+
+template <typename Rep = TickTimer::rep, typename Period = TickTimer::period>
+auto waitAny(AwaitableEventFlags &eventFlags, const EventFlags::Bitmask &bitMask, const std::chrono::duration<Rep, Period> &duration = TickTimer::waitForever, const EventFlags::Option option = EventFlags::Option::clear)
+{
+    return EventFlagsAwaiter{eventFlags, bitMask, false, option, TickTimer::ticks(duration)};
+}
+
+template <typename Rep = TickTimer::rep, typename Period = TickTimer::period>
+auto waitAll(AwaitableEventFlags &eventFlags, const EventFlags::Bitmask &bitMask, const std::chrono::duration<Rep, Period> &duration = TickTimer::waitForever, const EventFlags::Option option = EventFlags::Option::clear)
+{
+    return EventFlagsAwaiter{eventFlags, bitMask, true, option, TickTimer::ticks(duration)};
+}
+
+template <typename Rep, typename Period> auto sleepFor(const std::chrono::duration<Rep, Period> &duration)
+{
+    return SleepAwaiter{TickTimer::ticks(duration)};
+}
+
+template <class Clock, typename Duration> auto sleepUntil(const std::chrono::time_point<Clock, Duration> &time)
+{
+    return sleepFor(time - Clock::now());
+}
+} // namespace ThreadX::Await
@@ -0,0 +1,226 @@
+#include "fastMutex.hpp"
+#include "kernel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace ThreadX
+{
+FastMutex::FastMutex(const std::string_view name) : m_waitSemaphore{name}
+{
+}
+
+Error FastMutex::lock()
+{
+    return try_lock_for(TickTimer::waitForever);
+}
+
+Error FastMutex::try_lock()
+{
+    return try_lock_for(TickTimer::noWait);
+}
+
+Error FastMutex::unlock()
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    auto state{m_state.load(std::memory_order_relaxed)};
+    if ((state & ~contendedBit) != uintptr_t(threadPtr) or not threadPtr)
+    {
+        return Error::notOwned;
+    }
+
+    if (--m_ownershipCount > 0)
+    {
+        return Error::success;
+    }
+
+    if (auto expected{uintptr_t(threadPtr)}; m_state.compare_exchange_strong(expected, 0, std::memory_order_release, std::memory_order_relaxed))
+    {
+        return Error::success;
+    }
+
+    // contended: the owner word and the raised priority must be given up together, see inherit().
+    bool raised{};
+    Uint priority{};
+    {
+        Kernel::CriticalSection cs;
+        raised = std::exchange(m_ownerRaised, false);
+        if (raised)
+        {
+            for (auto nextPtr{std::addressof(m_raisedListHead)}; *nextPtr; nextPtr = std::addressof((*nextPtr)->m_raisedNext))
+            {
+                if (*nextPtr == this)
+                {
+                    *nextPtr = m_raisedNext;
+                    break;
+                }
+            }
+
+            // a priority other than the one inheritance gave us was set on purpose, so it stays.
+            raised = threadPtr->tx_thread_priority == raisedPriority(threadPtr, m_raisedPriority);
+            priority = raisedPriority(threadPtr, m_ownerPriority);
+        }
+
+        m_state.store(0);
+    }
+
+    if (m_waiters.load() > 0)
+    {
+        [[maybe_unused]] auto error{m_waitSemaphore.release()}; // a pending wakeup already does the job.
+        assert(error == Error::success or error == Error::ceilingExceeded);
+    }
+
+    if (raised)
+    {
+        // the woken waiter preempts us here, if it has a higher priority than ours.
+        Uint oldPriority{};
+        [[maybe_unused]] Error error{Native::tx_thread_priority_change(threadPtr, priority, std::addressof(oldPriority))};
+        assert(error == Error::success);
+    }
+
+    return Error::success;
+}
+
+std::string_view FastMutex::name() const
+{
+    return m_waitSemaphore.name();
+}
+
+uintptr_t FastMutex::lockingThreadID() const
+{
+    return m_state.load(std::memory_order_relaxed) & ~contendedBit;
+}
+
+Error FastMutex::get(const Ulong ticks)
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    if (not threadPtr)
+    {
+        return Error::callerError;
+    }
+
+    if ((m_state.load(std::memory_order_relaxed) & ~contendedBit) == uintptr_t(threadPtr))
+    {
+        ++m_ownershipCount;
+        return Error::success;
+    }
+
+    if (uintptr_t expected{}; m_state.compare_exchange_strong(expected, uintptr_t(threadPtr), std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        m_ownershipCount = 1;
+        return Error::success;
+    }
+
+    if (ticks == TickTimer::noWait.count())
+    {
+        return Error::notAvailable;
+    }
+
+    return wait(threadPtr, ticks);
+}
+
+Error FastMutex::wait(Native::TX_THREAD *const threadPtr, const Ulong ticks)
+{
+    Timeout timeout{ticks};
+    ++m_waiters;
+
+    while (true)
+    {
+        auto state{m_state.load()};
+        if (state == 0)
+        {
+            // other waiters may be left, so keep the contended bit for our unlock() to wake them.
+            if (m_state.compare_exchange_strong(state, uintptr_t(threadPtr) | contendedBit))
+            {
+                --m_waiters;
+                m_ownershipCount = 1;
+                return Error::success;
+            }
+
+            continue;
+        }
+
+        if (not(state & contendedBit) and not m_state.compare_exchange_strong(state, state | contendedBit))
+        {
+            continue;
+        }
+
+        inherit(threadPtr);
+
+        if (auto error{m_waitSemaphore.tryAcquireFor(TickTimer::Duration{timeout.remaining()})}; error != Error::success)
+        {
+            --m_waiters;
+            return error == Error::noInstance ? Error::notAvailable : error;
+        }
+    }
+}
+
+void FastMutex::inherit(Native::TX_THREAD *const threadPtr)
+{
+    Native::TX_THREAD *ownerPtr{};
+    {
+        // the original priority is saved once per ownership, and dropped by unlock() together with the ownership. A
+        // mutex whose waiter is not above the owner's current priority is recorded too, so that unlocking another
+        // FastMutex does not drop the owner below this waiter.
+        Kernel::CriticalSection cs;
+        ownerPtr = reinterpret_cast<Native::TX_THREAD *>(m_state.load() & ~contendedBit);
+        if (not ownerPtr)
+        {
+            return;
+        }
+
+        const auto otherPtr{m_ownerRaised ? this : raisedBy(ownerPtr)};
+        const auto ownerPriority{otherPtr ? otherPtr->m_ownerPriority : ownerPtr->tx_thread_user_priority};
+        if (threadPtr->tx_thread_priority >= ownerPriority)
+        {
+            return;
+        }
+
+        if (not m_ownerRaised)
+        {
+            m_ownerPriority = ownerPriority;
+            m_raisedPriority = threadPtr->tx_thread_priority;
+            m_ownerRaised = true;
+            m_raisedNext = m_raisedListHead;
+            m_raisedListHead = this;
+        }
+
+        m_raisedPriority = std::min(m_raisedPriority, threadPtr->tx_thread_priority);
+        if (threadPtr->tx_thread_priority >= ownerPtr->tx_thread_priority)
+        {
+            return;
+        }
+    }
+
+    // the owner has a lower priority than us, so it cannot run and release the mutex before this call.
+    Uint oldPriority{};
+    [[maybe_unused]] Error error{Native::tx_thread_priority_change(ownerPtr, threadPtr->tx_thread_priority, std::addressof(oldPriority))};
+    assert(error == Error::success);
+}
+
+Uint FastMutex::raisedPriority(const Native::TX_THREAD *const threadPtr, Uint priority)
+{
+    for (auto mutexPtr{m_raisedListHead}; mutexPtr; mutexPtr = mutexPtr->m_raisedNext)
+    {
+        if ((mutexPtr->m_state.load() & ~contendedBit) == uintptr_t(threadPtr))
+        {
+            priority = std::min(priority, mutexPtr->m_raisedPriority);
+        }
+    }
+
+    return priority;
+}
+
+FastMutex *FastMutex::raisedBy(const Native::TX_THREAD *const threadPtr)
+{
+    for (auto mutexPtr{m_raisedListHead}; mutexPtr; mutexPtr = mutexPtr->m_raisedNext)
+    {
+        if ((mutexPtr->m_state.load() & ~contendedBit) == uintptr_t(threadPtr))
+        {
+            return mutexPtr;
+        }
+    }
+
+    return nullptr;
+}
+} // namespace ThreadX
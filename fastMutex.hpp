@@ -0,0 +1,79 @@
+#pragma once
+
+#include "semaphore.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <atomic>
+#include <mutex>
+#include <string_view>
+
+namespace ThreadX
+{
+/// Recursive mutex that takes and gives ownership with an atomic compare-exchange when there is no contention, and only
+/// calls the kernel when a thread has to wait. A waiting thread raises the owner to its own priority, like a Mutex with
+/// InheritMode::inherit. Woken waiters compete for the lock again, so ownership is not handed over in priority or FIFO order.
+/// An owner of several FastMutexes goes back to the priority of the highest waiter of the ones it still owns on unlock().
+/// If the owner's priority is changed while it is raised, the change is kept rather than undone by unlock().
+/// Same interface as Mutex, so it works with std::lock_guard and std::unique_lock.
+class FastMutex
+{
+  public:
+    explicit FastMutex(const std::string_view name = "fastMutex");
+
+    FastMutex(const FastMutex &) = delete;
+    FastMutex &operator=(const FastMutex &) = delete;
+
+    /// obtains exclusive ownership. If the calling thread already owns the mutex, an internal counter is incremented.
+    Error lock();
+
+    Error try_lock();
+
+    template <class Clock, typename Duration> auto try_lock_until(const std::chrono::time_point<Clock, Duration> &time);
+
+    template <typename Rep, typename Period> auto try_lock_for(const std::chrono::duration<Rep, Period> &duration);
+
+    /// decrements the ownership count. If the ownership count is zero, the mutex is made available.
+    Error unlock();
+
+    std::string_view name() const;
+
+    uintptr_t lockingThreadID() const;
+
+  private:
+    static constexpr uintptr_t contendedBit{1}; // set by waiters, so that unlock() takes the path that wakes them.
+
+    Error get(const Ulong ticks);
+    Error wait(Native::TX_THREAD *const threadPtr, const Ulong ticks);
+    void inherit(Native::TX_THREAD *const threadPtr);
+
+    /// \return highest of priority and the priorities given to threadPtr by the other raised FastMutexes it owns
+    static Uint raisedPriority(const Native::TX_THREAD *const threadPtr, Uint priority);
+
+    /// \return another raised FastMutex owned by threadPtr, nullptr if there is none
+    static FastMutex *raisedBy(const Native::TX_THREAD *const threadPtr);
+
+    static inline FastMutex *m_raisedListHead{}; // FastMutexes whose owner is raised, linked under a critical section
+
+    std::atomic<uintptr_t> m_state{}; // owner thread pointer | contendedBit
+    Ulong m_ownershipCount{};
+    std::atomic<Ulong> m_waiters{};
+    bool m_ownerRaised{};
+    Uint m_ownerPriority{};  // before the owner was raised by any FastMutex
+    Uint m_raisedPriority{}; // the owner was raised to
+    FastMutex *m_raisedNext{};
+    BinarySemaphore m_waitSemaphore;
+};
+
+template <class Clock, typename Duration> auto FastMutex::try_lock_until(const std::chrono::time_point<Clock, Duration> &time)
+{
+    return try_lock_for(time - Clock::now());
+}
+
+template <typename Rep, typename Period> auto FastMutex::try_lock_for(const std::chrono::duration<Rep, Period> &duration)
+{
+    return get(TickTimer::ticks(duration));
+}
+
+using FastLockGuard = std::lock_guard<FastMutex>;
+using FastUniqueLock = std::unique_lock<FastMutex>;
+} // namespace ThreadX
@@ -0,0 +1,141 @@
+#include "highResClock.hpp"
+#include "kernel.hpp"
+#include <algorithm>
+#include <cassert>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace ThreadX
+{
+namespace
+{
+constexpr Ulong64 counterWrap{Ulong64{1} << 32};
+
+#ifdef __linux__
+Ulong64 monotonicNanoseconds()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return Ulong64(time.tv_sec) * std::nano::den + Ulong64(time.tv_nsec);
+}
+#endif
+} // namespace
+
+HighResClock::TimePoint HighResClock::now()
+{
+    return TimePoint{toDuration(cycles())};
+}
+
+Ulong64 HighResClock::cycles()
+{
+#ifdef __linux__
+    if (not m_counter and not m_counter64)
+    {
+        source(monotonicNanoseconds, std::nano::den);
+    }
+#endif
+    if (m_counter64)
+    {
+        // a 64-bit counter does not wrap, so it needs no extending and no critical section.
+        return m_counter64() - m_referenceCycles;
+    }
+
+    if (not m_counter)
+    {
+        // without a source the clock has tick resolution, so that it can be read from the start.
+        return Native::tx_time_get();
+    }
+
+    Kernel::CriticalSection cs;
+    const Ulong ticks{Native::tx_time_get()};
+    const Ulong64 count{Ulong64{m_counter()} % counterWrap};
+
+    // the ticks since the last reading give the counter value to within a tick, which picks the wrap the count belongs to.
+    // Anchoring on the last reading keeps the rounding of m_cyclesPerTick from adding up.
+    const auto estimate{m_anchorCycles + Ulong64{Ulong(ticks - m_anchorTicks)} * m_cyclesPerTick};
+    auto extended{estimate - estimate % counterWrap + count};
+    if (extended > estimate + counterWrap / 2 and extended >= counterWrap)
+    {
+        extended -= counterWrap;
+    }
+    else if (extended + counterWrap / 2 < estimate)
+    {
+        extended += counterWrap;
+    }
+
+    // the tick count may lag behind the counter while the tick interrupt is pending.
+    m_anchorTicks = ticks;
+    m_anchorCycles = extended;
+    m_lastCycles = std::max(m_lastCycles, extended);
+    return m_lastCycles - m_referenceCycles;
+}
+
+Ulong HighResClock::count()
+{
+    if (m_counter64)
+    {
+        return Ulong(m_counter64());
+    }
+
+    return m_counter ? m_counter() : 0;
+}
+
+void HighResClock::source(const Counter counter, const Ulong frequency)
+{
+    assert(counter and frequency >= TX_TIMER_TICKS_PER_SECOND);
+
+    Kernel::CriticalSection cs;
+    m_counter = counter;
+    m_counter64 = nullptr;
+    m_frequency = frequency;
+    m_cyclesPerTick = frequency / TX_TIMER_TICKS_PER_SECOND;
+    m_referenceTicks = Native::tx_time_get();
+    m_referenceCycles = Ulong64{counter()} % counterWrap;
+    m_anchorTicks = m_referenceTicks;
+    m_anchorCycles = m_referenceCycles;
+    m_lastCycles = m_referenceCycles;
+}
+
+void HighResClock::source(const Counter64 counter, const Ulong frequency)
+{
+    assert(counter and frequency >= TX_TIMER_TICKS_PER_SECOND);
+
+    Kernel::CriticalSection cs;
+    m_counter = nullptr;
+    m_counter64 = counter;
+    m_frequency = frequency;
+    m_referenceTicks = Native::tx_time_get();
+    m_referenceCycles = counter();
+}
+
+#if defined(__ARM_ARCH_7M__) or defined(__ARM_ARCH_7EM__) or defined(__ARM_ARCH_8M_MAIN__)
+void HighResClock::useCycleCounter(const Ulong cpuFrequency)
+{
+    auto &demcr{*reinterpret_cast<volatile Ulong *>(0xE000EDFC)};
+    auto &dwtControl{*reinterpret_cast<volatile Ulong *>(0xE0001000)};
+    demcr = demcr | (Ulong{1} << 24); // TRCENA
+    dwtControl = dwtControl | 1;      // CYCCNTENA
+
+    source([]() { return Ulong{*reinterpret_cast<volatile Ulong *>(0xE0001004)}; }, cpuFrequency);
+}
+#endif
+
+Ulong HighResClock::frequency()
+{
+    return m_frequency;
+}
+
+TickTimer::TimePoint HighResClock::toTickTime(const TimePoint time)
+{
+    return TickTimer::TimePoint{TickTimer::Duration{m_referenceTicks} + std::chrono::floor<TickTimer::Duration>(time.time_since_epoch())};
+}
+
+HighResClock::Duration HighResClock::toDuration(const Ulong64 cycles)
+{
+    // split so that the product cannot overflow for any counter frequency. Without a source, cycles are ticks.
+    const Ulong64 frequency{m_frequency ? m_frequency : TX_TIMER_TICKS_PER_SECOND};
+    return Duration{cycles / frequency * std::nano::den + cycles % frequency * std::nano::den / frequency};
+}
+} // namespace ThreadX
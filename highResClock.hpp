@@ -0,0 +1,85 @@
+#pragma once
+
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <chrono>
+#include <ratio>
+
+namespace ThreadX
+{
+/// Monotonic clock with nanosecond resolution, read from a free-running 32-bit hardware counter. The counter is extended
+/// to 64 bits with the tick count, which tells how many times it has wrapped, so the clock does not need to be read at
+/// least once per wrap. The extension takes a short critical section on every reading. A 64-bit counter is read as it
+/// is, without one. Converting a reading to nanoseconds takes two 64-bit divisions. Time zero is the tick count at which
+/// the source was set. The DWT cycle counter is available on Cortex-M3 and up, and the 64-bit CLOCK_MONOTONIC on the
+/// Linux port, where it is the default.
+/// Until a source is set, the clock counts ticks, so its readings are only as fine as the tick. Set the source before the
+/// clock is first read, as time starts from zero again when it is set.
+class HighResClock
+{
+  public:
+    /// reads the counter. Only the low 32 bits are used.
+    using Counter = Ulong (*)();
+    /// reads a counter that does not wrap.
+    using Counter64 = Ulong64 (*)();
+
+    using rep = Ulong64;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using Duration = duration;
+    using time_point = std::chrono::time_point<HighResClock, Duration>;
+    using TimePoint = time_point;
+
+    static constexpr bool is_steady = true;
+
+    /// May be called from ISRs.
+    static TimePoint now();
+
+    /// \return counter cycles since the source was set, extended to 64 bits. Ticks if there is no source.
+    static Ulong64 cycles();
+
+    /// \return raw counter reading, for short intervals measured where a critical section cannot be taken. 0 if there is
+    /// no source yet.
+    static Ulong count();
+
+    /// sets the counter to read.
+    /// \param frequency counter frequency in Hz, at least TX_TIMER_TICKS_PER_SECOND
+    static void source(const Counter counter, const Ulong frequency);
+    static void source(const Counter64 counter, const Ulong frequency);
+
+#if defined(__ARM_ARCH_7M__) or defined(__ARM_ARCH_7EM__) or defined(__ARM_ARCH_8M_MAIN__)
+    /// enables the DWT cycle counter and sets it as the source.
+    /// \param cpuFrequency core clock in Hz
+    static void useCycleCounter(const Ulong cpuFrequency);
+#endif
+
+    /// \return counter frequency in Hz, 0 if there is no source
+    static Ulong frequency();
+
+    /// \return duration in ticks, rounded up like TickTimer::ticks()
+    template <typename Rep, typename Period> static constexpr TickTimer::Duration toTicks(const std::chrono::duration<Rep, Period> &duration);
+
+    /// \return tick count at the given time
+    static TickTimer::TimePoint toTickTime(const TimePoint time);
+
+  private:
+    static Duration toDuration(const Ulong64 cycles);
+
+    static inline Counter m_counter{};
+    static inline Counter64 m_counter64{};
+    static inline Ulong m_frequency{};
+    static inline Ulong m_cyclesPerTick{};
+    static inline Ulong m_referenceTicks{};
+    static inline Ulong64 m_referenceCycles{}; // counter value when the source was set
+    static inline Ulong m_anchorTicks{};
+    static inline Ulong64 m_anchorCycles{}; // extended counter value at the last reading
+    static inline Ulong64 m_lastCycles{};
+};
+
+static_assert(std::chrono::is_clock_v<HighResClock>);
+
+template <typename Rep, typename Period> constexpr TickTimer::Duration HighResClock::toTicks(const std::chrono::duration<Rep, Period> &duration)
+{
+    return TickTimer::Duration{TickTimer::ticks(duration)};
+}
+} // namespace ThreadX
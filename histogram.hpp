@@ -0,0 +1,115 @@
+#pragma once
+
+#include "txCommon.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace ThreadX
+{
+/// Fixed-size histogram with linear bins, for latency and execution time statistics.
+/// The last bin collects every sample beyond the covered range.
+/// \tparam Bins number of bins
+template <size_t Bins> class Histogram
+{
+    static_assert(Bins > 0);
+
+  public:
+    /// \param binWidth width of each bin in sample units
+    explicit Histogram(const Ulong binWidth = 1);
+
+    void insert(const Ulong sample);
+    void clear();
+
+    auto binWidth() const;
+    auto bins() const;
+    auto count() const;
+    auto min() const;
+    auto max() const;
+    auto mean() const;
+
+    /// Returns the upper bound of the bin the given percentile of samples falls in.
+    /// \param percent 0 to 100
+    auto percentile(const Uint percent) const;
+
+  private:
+    Ulong m_binWidth;
+    std::array<Ulong, Bins> m_bins{};
+    Ulong m_count{};
+    Ulong m_min{std::numeric_limits<Ulong>::max()};
+    Ulong m_max{};
+    Ulong64 m_sum{};
+};
+
+template <size_t Bins> Histogram<Bins>::Histogram(const Ulong binWidth) : m_binWidth{binWidth}
+{
+    assert(binWidth > 0);
+}
+
+template <size_t Bins> void Histogram<Bins>::insert(const Ulong sample)
+{
+    ++m_bins[std::min(sample / m_binWidth, Ulong{Bins - 1})];
+    ++m_count;
+    m_min = std::min(m_min, sample);
+    m_max = std::max(m_max, sample);
+    m_sum += sample;
+}
+
+template <size_t Bins> void Histogram<Bins>::clear()
+{
+    m_bins.fill(0);
+    m_count = 0;
+    m_min = std::numeric_limits<Ulong>::max();
+    m_max = 0;
+    m_sum = 0;
+}
+
+template <size_t Bins> auto Histogram<Bins>::binWidth() const
+{
+    return m_binWidth;
+}
+
+template <size_t Bins> auto Histogram<Bins>::bins() const
+{
+    return m_bins;
+}
+
+template <size_t Bins> auto Histogram<Bins>::count() const
+{
+    return m_count;
+}
+
+template <size_t Bins> auto Histogram<Bins>::min() const
+{
+    return m_count ? m_min : 0;
+}
+
+template <size_t Bins> auto Histogram<Bins>::max() const
+{
+    return m_max;
+}
+
+template <size_t Bins> auto Histogram<Bins>::mean() const
+{
+    return m_count ? Ulong(m_sum / m_count) : 0;
+}
+
+template <size_t Bins> auto Histogram<Bins>::percentile(const Uint percent) const
+{
+    assert(percent <= 100);
+
+    const auto target{(Ulong64{m_count} * percent + 99) / 100};
+    Ulong64 cumulative{};
+    for (size_t bin{}; bin < Bins; ++bin)
+    {
+        cumulative += m_bins[bin];
+        if (cumulative >= target and cumulative > 0)
+        {
+            return bin == Bins - 1 ? m_max : Ulong((bin + 1) * m_binWidth - 1);
+        }
+    }
+
+    return m_max;
+}
+} // namespace ThreadX
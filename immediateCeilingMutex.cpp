@@ -0,0 +1,146 @@
+#include "immediateCeilingMutex.hpp"
+#include <cassert>
+
+namespace ThreadX
+{
+ImmediateCeilingMutex::ImmediateCeilingMutex(const Uint ceiling, const CeilingMode mode) : ImmediateCeilingMutex{"immediateCeilingMutex", ceiling, mode}
+{
+}
+
+ImmediateCeilingMutex::ImmediateCeilingMutex(const std::string_view name, const Uint ceiling, const CeilingMode mode) : m_ceiling{ceiling}, m_mode{mode}, m_mutex{name}
+{
+    assert(ceiling < TX_MAX_PRIORITIES);
+}
+
+void ImmediateCeilingMutex::registerViolationCallback(const ViolationCallback &violationCallback)
+{
+    m_violationCallback = violationCallback;
+}
+
+Error ImmediateCeilingMutex::lock()
+{
+    return try_lock_for(TickTimer::waitForever);
+}
+
+Error ImmediateCeilingMutex::try_lock()
+{
+    return try_lock_for(TickTimer::noWait);
+}
+
+Error ImmediateCeilingMutex::unlock()
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    if (not threadPtr or m_mutex.lockingThreadID() != uintptr_t(threadPtr))
+    {
+        return Error::notOwned;
+    }
+
+    const auto last{--m_ownershipCount == 0};
+    const auto previous{m_previous};
+    if (Error error{m_mutex.unlock()}; error != Error::success or not last)
+    {
+        return error;
+    }
+
+    // a waiting user of the mutex can only run from here on.
+    return restore(threadPtr, previous);
+}
+
+std::string_view ImmediateCeilingMutex::name() const
+{
+    return m_mutex.name();
+}
+
+Uint ImmediateCeilingMutex::ceiling() const
+{
+    return m_ceiling;
+}
+
+CeilingMode ImmediateCeilingMutex::mode() const
+{
+    return m_mode;
+}
+
+uintptr_t ImmediateCeilingMutex::lockingThreadID() const
+{
+    return m_mutex.lockingThreadID();
+}
+
+Error ImmediateCeilingMutex::get(const Ulong ticks)
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    if (not threadPtr)
+    {
+        return Error::callerError;
+    }
+
+    if (m_mutex.lockingThreadID() == uintptr_t(threadPtr))
+    {
+        ++m_ownershipCount;
+        return m_mutex.lock();
+    }
+
+    Uint previous{};
+    if (Error error{raise(threadPtr, previous)}; error != Error::success)
+    {
+        return error;
+    }
+
+    Error error{m_mutex.try_lock()};
+    if (error == Error::notAvailable and ticks != TickTimer::noWait.count())
+    {
+        violation(CeilingViolation::contended);
+        error = m_mutex.try_lock_for(TickTimer::Duration{ticks});
+    }
+
+    if (error != Error::success)
+    {
+        [[maybe_unused]] auto restoreError{restore(threadPtr, previous)};
+        assert(restoreError == Error::success);
+        return error;
+    }
+
+    m_previous = previous;
+    m_ownershipCount = 1;
+    return Error::success;
+}
+
+Error ImmediateCeilingMutex::raise(Native::TX_THREAD *const threadPtr, Uint &previous)
+{
+    if (threadPtr->tx_thread_user_priority < m_ceiling)
+    {
+        violation(CeilingViolation::priorityAboveCeiling);
+    }
+
+    if (m_mode == CeilingMode::priority)
+    {
+        previous = threadPtr->tx_thread_user_priority;
+        return previous > m_ceiling ? Error{Native::tx_thread_priority_change(threadPtr, m_ceiling, std::addressof(previous))} : Error::success;
+    }
+
+    // the threshold is at least the thread's own priority, so in a violation it is already above the ceiling.
+    previous = threadPtr->tx_thread_user_preempt_threshold;
+    return previous > m_ceiling ? Error{Native::tx_thread_preemption_change(threadPtr, m_ceiling, std::addressof(previous))} : Error::success;
+}
+
+Error ImmediateCeilingMutex::restore(Native::TX_THREAD *const threadPtr, const Uint previous)
+{
+    Uint oldValue{};
+    if (m_mode == CeilingMode::priority)
+    {
+        return previous > m_ceiling ? Error{Native::tx_thread_priority_change(threadPtr, previous, std::addressof(oldValue))} : Error::success;
+    }
+
+    return previous > m_ceiling ? Error{Native::tx_thread_preemption_change(threadPtr, previous, std::addressof(oldValue))} : Error::success;
+}
+
+void ImmediateCeilingMutex::violation([[maybe_unused]] const CeilingViolation violation)
+{
+#ifndef NDEBUG
+    if (m_violationCallback)
+    {
+        m_violationCallback(*this, violation);
+    }
+#endif
+}
+} // namespace ThreadX
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "fastMutex.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+namespace ThreadX
+{
+/// How ImmediateCeilingMutex keeps other users of the mutex from running while it is held.
+enum class CeilingMode : Uint
+{
+    preemptionThreshold, ///< raises the preemption-threshold, so the owner keeps its priority for threads that do not use the mutex
+    priority             ///< raises the priority
+};
+
+/// Kinds of ceiling violations reported in debug builds.
+enum class CeilingViolation : Uint
+{
+    priorityAboveCeiling, ///< the locking thread has a higher priority than the ceiling
+    contended             ///< the mutex was held by another thread, which means that the owner blocked while holding it
+};
+
+/// Mutex with the immediate priority ceiling protocol. On lock, the calling thread is raised to the ceiling, which must be
+/// the highest priority of all threads that use the mutex. No other user can then run until it is unlocked, so on a
+/// single core the mutex is never contended unless the owner blocks while holding it, and ceiling mutexes cannot
+/// deadlock each other. Nested ceiling mutexes must be unlocked in reverse order of locking.
+/// Same interface as Mutex, so it works with std::lock_guard and std::unique_lock.
+class ImmediateCeilingMutex
+{
+  public:
+    using ViolationCallback = std::function<void(ImmediateCeilingMutex &, const CeilingViolation)>;
+
+    /// \param ceiling highest priority, i.e. lowest priority number, of the threads that lock the mutex
+    explicit ImmediateCeilingMutex(const Uint ceiling, const CeilingMode mode = CeilingMode::preemptionThreshold);
+    explicit ImmediateCeilingMutex(const std::string_view name, const Uint ceiling, const CeilingMode mode = CeilingMode::preemptionThreshold);
+
+    ImmediateCeilingMutex(const ImmediateCeilingMutex &) = delete;
+    ImmediateCeilingMutex &operator=(const ImmediateCeilingMutex &) = delete;
+
+    /// Registers a callback for ceiling violations. It is only called in debug builds, from the locking thread.
+    static void registerViolationCallback(const ViolationCallback &violationCallback);
+
+    /// raises the calling thread to the ceiling and obtains exclusive ownership. If the calling thread already owns the
+    /// mutex, an internal counter is incremented.
+    Error lock();
+
+    Error try_lock();
+
+    template <class Clock, typename Duration> auto try_lock_until(const std::chrono::time_point<Clock, Duration> &time);
+
+    template <typename Rep, typename Period> auto try_lock_for(const std::chrono::duration<Rep, Period> &duration);
+
+    /// decrements the ownership count. If the ownership count is zero, the mutex is made available and the calling
+    /// thread returns to the priority or preemption-threshold it had before locking.
+    Error unlock();
+
+    std::string_view name() const;
+
+    Uint ceiling() const;
+
+    CeilingMode mode() const;
+
+    uintptr_t lockingThreadID() const;
+
+  private:
+    Error get(const Ulong ticks);
+    Error raise(Native::TX_THREAD *const threadPtr, Uint &previous);
+    Error restore(Native::TX_THREAD *const threadPtr, const Uint previous);
+    void violation(const CeilingViolation violation);
+
+    static inline ViolationCallback m_violationCallback;
+
+    const Uint m_ceiling;
+    const CeilingMode m_mode;
+    Uint m_previous{}; // priority or preemption-threshold of the owner before it locked the mutex
+    Ulong m_ownershipCount{};
+    FastMutex m_mutex;
+};
+
+template <class Clock, typename Duration> auto ImmediateCeilingMutex::try_lock_until(const std::chrono::time_point<Clock, Duration> &time)
+{
+    return try_lock_for(time - Clock::now());
+}
+
+template <typename Rep, typename Period> auto ImmediateCeilingMutex::try_lock_for(const std::chrono::duration<Rep, Period> &duration)
+{
+    return get(TickTimer::ticks(duration));
+}
+
+using CeilingLockGuard = std::lock_guard<ImmediateCeilingMutex>;
+using CeilingUniqueLock = std::unique_lock<ImmediateCeilingMutex>;
+} // namespace ThreadX
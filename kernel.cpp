@@ -1,10 +1,18 @@
 #include "kernel.hpp"
+#include <cassert>
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+#include "highResClock.hpp"
+#include <algorithm>
+#include <limits>
+#include <ratio>
+#endif
 
 namespace ThreadX::Kernel
 {
-CriticalSection::CriticalSection()
+CriticalSection::CriticalSection(const std::source_location location)
 {
-    lock();
+    lock(location);
 }
 
 CriticalSection::~CriticalSection()
@@ -12,26 +20,70 @@ CriticalSection::~CriticalSection()
     unlock();
 }
 
-void CriticalSection::lock()
+void CriticalSection::lock([[maybe_unused]] const std::source_location location)
 {
-    if (not m_locked.test_and_set())
+    assert(not m_locked);
+    m_posture = Native::tx_interrupt_control(TX_INT_DISABLE);
+    m_locked = true;
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+    // nested critical sections are part of the outermost one. One that sets the source started without a counter, so it
+    // is not timed.
+    if (m_depth++ == 0)
     {
-        using namespace Native;
-        TX_DISABLE
+        m_location = location;
+        m_frequency = HighResClock::frequency();
+        m_start = HighResClock::count();
     }
+#endif
 }
 
 void CriticalSection::unlock()
 {
-    if (m_locked.test())
+    if (not m_locked)
     {
-        Native::TX_RESTORE;
-        m_locked.clear();
+        return;
     }
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+    if (--m_depth == 0 and m_frequency > 0)
+    {
+        const Ulong cycles{HighResClock::count() - m_start};
+        const Ulong duration(std::min(Ulong64{cycles} * std::nano::den / m_frequency, Ulong64{std::numeric_limits<Ulong>::max()}));
+        if (duration >= m_profile.durations.max())
+        {
+            m_profile.worstSite = m_location;
+        }
+
+        m_profile.durations.insert(duration);
+    }
+#endif
+
+    m_locked = false;
+    Native::tx_interrupt_control(m_posture);
+}
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+CriticalSectionProfile CriticalSection::profile()
+{
+    CriticalSection cs;
+    return m_profile;
+}
+
+void CriticalSection::clearProfile()
+{
+    CriticalSection cs;
+    m_profile.durations.clear();
+    m_profile.worstSite = {};
 }
+#endif
 
 void start()
 {
+#if defined(THREADX_CRITICAL_SECTION_PROFILE) and defined(__linux__)
+    // sets the default source of the Linux port, so that critical sections are timed from the start.
+    [[maybe_unused]] const auto now{HighResClock::now()};
+#endif
     Native::tx_kernel_enter();
 }
 
@@ -1,7 +1,15 @@
 #pragma once
 
 #include "txCommon.hpp"
-#include <atomic>
+#include <source_location>
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+#include "histogram.hpp"
+
+#ifndef THREADX_CRITICAL_SECTION_BIN_WIDTH
+#define THREADX_CRITICAL_SECTION_BIN_WIDTH 1000
+#endif
+#endif
 
 namespace ThreadX::Native
 {
@@ -19,21 +27,54 @@ enum class State
     running
 };
 
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+/// Interrupt lockout statistics of the outermost critical sections, collected when THREADX_CRITICAL_SECTION_PROFILE
+/// is defined. Durations are in nanoseconds of HighResClock, and are only measured once it has a source. Durations over
+/// the range of a Ulong, about 4.29 s, are recorded as its maximum.
+struct CriticalSectionProfile
+{
+    static constexpr size_t bins{16};
+
+    Histogram<bins> durations{THREADX_CRITICAL_SECTION_BIN_WIDTH};
+    std::source_location worstSite; ///< where the longest critical section was entered
+};
+#endif
+
 /// Basic lockable class that prevents task and interrupt context switches while locked.
 /// it can either be used as a scoped object or for freely lock/unlucking.
+/// Every object saves the interrupt posture it found, so critical sections nest, in threads and ISRs alike, as long as
+/// they are unlocked in reverse order of locking.
 class CriticalSection
 {
   public:
-    explicit CriticalSection();
+    explicit CriticalSection(const std::source_location location = std::source_location::current());
     ~CriticalSection();
+
+    CriticalSection(const CriticalSection &) = delete;
+    CriticalSection &operator=(const CriticalSection &) = delete;
+
     /// Locks the CPU, preventing thread and interrupt switches.
-    static void lock();
+    void lock(const std::source_location location = std::source_location::current());
     /// Unlocks the CPU, allowing other interrupts and threads to preempt the current execution context.
-    static void unlock();
+    void unlock();
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+    /// Returns a copy of the statistics.
+    static CriticalSectionProfile profile();
+    static void clearProfile();
+#endif
 
   private:
-    static inline std::atomic_flag m_locked = ATOMIC_FLAG_INIT;
-    static inline Native::TX_INTERRUPT_SAVE_AREA
+    Uint m_posture{}; // interrupt posture before locking
+    bool m_locked{};
+
+#ifdef THREADX_CRITICAL_SECTION_PROFILE
+    static inline Uint m_depth{}; // only changed with interrupts disabled
+    static inline CriticalSectionProfile m_profile{};
+    Ulong m_frequency{}; // of HighResClock at lock(), 0 if it had no source
+    Ulong m_start{};
+    std::source_location m_location;
+#endif
 };
 
 void start();
@@ -0,0 +1,50 @@
+#include "latch.hpp"
+#include <cassert>
+
+namespace ThreadX
+{
+Latch::Latch(const std::ptrdiff_t expected, const std::string_view name) : m_counter{expected}, m_eventFlags{name}
+{
+    assert(expected >= 0);
+
+    if (expected == 0)
+    {
+        [[maybe_unused]] auto error{m_eventFlags.set(openBit)};
+        assert(error == Error::success);
+    }
+}
+
+void Latch::count_down(const std::ptrdiff_t update)
+{
+    const auto previous{m_counter.fetch_sub(update)};
+    assert(previous >= update);
+
+    if (previous == update)
+    {
+        [[maybe_unused]] auto error{m_eventFlags.set(openBit)};
+        assert(error == Error::success);
+    }
+}
+
+bool Latch::try_wait() const noexcept
+{
+    return m_counter.load() == 0;
+}
+
+void Latch::wait() const
+{
+    if (try_wait())
+    {
+        return;
+    }
+
+    [[maybe_unused]] auto [error, flags]{m_eventFlags.waitAll(openBit, EventFlags::Option::dontClear)};
+    assert(error == Error::success);
+}
+
+void Latch::arrive_and_wait(const std::ptrdiff_t update)
+{
+    count_down(update);
+    wait();
+}
+} // namespace ThreadX
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "eventFlags.hpp"
+#include "txCommon.hpp"
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+
+namespace ThreadX
+{
+/// Single-use downward counter, equivalent to std::latch. Threads block until the counter reaches zero.
+/// The counter is atomic and only the last count_down() calls the kernel, so count_down() may be called from ISRs.
+class Latch
+{
+  public:
+    explicit Latch(const std::ptrdiff_t expected, const std::string_view name = "latch");
+
+    Latch(const Latch &) = delete;
+    Latch &operator=(const Latch &) = delete;
+
+    static constexpr std::ptrdiff_t max() noexcept;
+
+    /// decrements the counter, and releases the waiting threads when it reaches zero.
+    void count_down(const std::ptrdiff_t update = 1);
+
+    /// \return true if the counter has reached zero
+    bool try_wait() const noexcept;
+
+    void wait() const;
+
+    void arrive_and_wait(const std::ptrdiff_t update = 1);
+
+  private:
+    static constexpr EventFlags::Bitmask openBit{1};
+
+    std::atomic<std::ptrdiff_t> m_counter;
+    mutable EventFlags m_eventFlags;
+};
+
+constexpr std::ptrdiff_t Latch::max() noexcept
+{
+    return std::numeric_limits<std::ptrdiff_t>::max();
+}
+} // namespace ThreadX
@@ -0,0 +1,12 @@
+/* FileX configuration of the Linux host build (MCU_ARCH=linux). Used unless FX_USER_FILE is given. */
+#ifndef FX_USER_H
+#define FX_USER_H
+
+/* media are RAM disks on the host, so a large sector cache costs nothing. */
+#define FX_MAX_SECTOR_CACHE 256
+#define FX_FAT_MAP_SIZE 128
+
+#define FX_ENABLE_FAULT_TOLERANT
+#define FX_FAULT_TOLERANT_MAXIMUM_LOG_FILE_SIZE 3072
+
+#endif
@@ -0,0 +1,9 @@
+/* LevelX configuration of the Linux host build (MCU_ARCH=linux). Used unless LX_USER_FILE is given. */
+#ifndef LX_USER_H
+#define LX_USER_H
+
+/* NOR flash is simulated in RAM, but read through the driver so that NorFlash::readCallback() runs. */
+#define LX_NOR_SECTOR_MAPPING_CACHE_SIZE 16
+#define LX_THREAD_SAFE_ENABLE
+
+#endif
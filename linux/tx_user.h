@@ -0,0 +1,25 @@
+/* ThreadX configuration of the Linux host build (MCU_ARCH=linux). Used unless TX_USER_FILE is given. */
+#ifndef TX_USER_H
+#define TX_USER_H
+
+/* the Linux port drives the tick from a host thread that sleeps 10 ms. */
+#define TX_TIMER_TICKS_PER_SECOND 100
+
+/* service error checking stays on, as TX_DISABLE_ERROR_CHECKING is not defined, so that misuse of the wrapper shows up
+   on the host. */
+
+/* stack checking and the performance counters of every object type, for profiling on the host. */
+#define TX_ENABLE_STACK_CHECKING
+#define TX_THREAD_ENABLE_PERFORMANCE_INFO
+#define TX_MUTEX_ENABLE_PERFORMANCE_INFO
+#define TX_QUEUE_ENABLE_PERFORMANCE_INFO
+#define TX_SEMAPHORE_ENABLE_PERFORMANCE_INFO
+#define TX_EVENT_FLAGS_ENABLE_PERFORMANCE_INFO
+#define TX_BYTE_POOL_ENABLE_PERFORMANCE_INFO
+#define TX_BLOCK_POOL_ENABLE_PERFORMANCE_INFO
+#define TX_TIMER_ENABLE_PERFORMANCE_INFO
+
+/* event trace adds work to every service call. Enable it only to record a trace. */
+/* #define TX_ENABLE_EVENT_TRACE */
+
+#endif
@@ -0,0 +1,43 @@
+#include "memoryPool.hpp"
+#include "kernel.hpp"
+#include <algorithm>
+
+namespace ThreadX
+{
+BytePoolBase::Info BytePoolBase::info(Native::TX_BYTE_POOL &pool)
+{
+    using namespace Native;
+    // every fragment starts with a pointer to the next one and a word that marks it free. The last one points to the first.
+    constexpr auto overhead{sizeof(UCHAR *) + sizeof(ALIGN_TYPE)};
+    const auto threadPtr{tx_thread_identify()};
+
+    Kernel::CriticalSection cs;
+    Info info{};
+    UCHAR *fragmentPtr{};
+    do
+    {
+        // allocations set the owner before they search and releases clear it, so a different owner means the fragments
+        // may have been split or merged since the last one was read.
+        if (fragmentPtr == nullptr or pool.tx_byte_pool_owner != threadPtr)
+        {
+            pool.tx_byte_pool_owner = threadPtr;
+            info = {.available = pool.tx_byte_pool_available, .fragments = pool.tx_byte_pool_fragments, .largestFree = 0};
+            fragmentPtr = pool.tx_byte_pool_start;
+        }
+
+        auto nextPtr{*reinterpret_cast<UCHAR **>(fragmentPtr)};
+        if (*reinterpret_cast<ALIGN_TYPE *>(fragmentPtr + sizeof(UCHAR *)) == TX_BYTE_BLOCK_FREE)
+        {
+            info.largestFree = std::max(info.largestFree, Ulong(nextPtr - fragmentPtr - overhead));
+        }
+
+        fragmentPtr = nextPtr;
+
+        // lets interrupts and threads in between fragments.
+        cs.unlock();
+        cs.lock();
+    } while (fragmentPtr != pool.tx_byte_pool_start or pool.tx_byte_pool_owner != threadPtr);
+
+    return info;
+}
+} // namespace ThreadX
@@ -3,7 +3,9 @@
 #include "tickTimer.hpp"
 #include "txCommon.hpp"
 #include <array>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <cassert>
 
 namespace ThreadX
@@ -11,11 +13,21 @@ namespace ThreadX
 class BytePoolBase
 {
   public:
+    struct Info
+    {
+        Ulong available;   ///< free bytes, including the overhead of the free fragments
+        Ulong fragments;   ///< free and allocated fragments
+        Ulong largestFree; ///< largest size that can be allocated
+    };
+
     BytePoolBase(const BytePoolBase &) = delete;
     BytePoolBase &operator=(const BytePoolBase &) = delete;
 
   protected:
     explicit BytePoolBase() = default;
+
+    /// walks the fragments of pool one at a time, like tx_byte_pool_search, and starts over if the pool changes.
+    static Info info(Native::TX_BYTE_POOL &pool);
 };
 
 /// byte memory pool from which to allocate the thread stacks and queues.
@@ -27,9 +39,24 @@ template <Ulong Size> class BytePool : Native::TX_BYTE_POOL, BytePoolBase
   public:
     template <class Pool> friend class Allocation;
 
+    using Info = BytePoolBase::Info;
+
     explicit BytePool(const std::string_view name);
     ~BytePool();
 
+    /// allocates memory for callers that manage its lifetime themselves. Otherwise use Allocation.
+    /// \return error and pointer to the memory, nullptr on error
+    template <typename Rep = TickTimer::rep, typename Period = TickTimer::period>
+    auto allocate(const Ulong memorySizeInBytes, const std::chrono::duration<Rep, Period> &duration = TickTimer::noWait);
+
+    /// returns memory obtained by allocate() to its pool.
+    static auto release(std::byte *const memoryPtr);
+
+    /// walks the fragments with interrupts enabled between them, so it only delays allocations and releases on the pool,
+    /// which also make it start over. For diagnostics.
+    /// The pool is fragmented when largestFree is well below available.
+    auto info() const;
+
     /// Places the highest priority thread suspended for memory on this pool at the front of the suspension list.
     /// All other threads remain in the same FIFO order they were suspended in.
     auto prioritise();
@@ -52,6 +79,26 @@ template <Ulong Size> BytePool<Size>::~BytePool()
     assert(error == Error::success);
 }
 
+template <Ulong Size>
+template <typename Rep, typename Period>
+auto BytePool<Size>::allocate(const Ulong memorySizeInBytes, const std::chrono::duration<Rep, Period> &duration)
+{
+    std::byte *memoryPtr{};
+    Error error{tx_byte_allocate(this, reinterpret_cast<void **>(std::addressof(memoryPtr)), memorySizeInBytes, TickTimer::ticks(duration))};
+    return std::pair{error, memoryPtr};
+}
+
+template <Ulong Size> auto BytePool<Size>::release(std::byte *const memoryPtr)
+{
+    return Error{Native::tx_byte_release(memoryPtr)};
+}
+
+template <Ulong Size> auto BytePool<Size>::info() const
+{
+    // the walk claims the pool's search owner, as an allocation does, to notice changes made while it is preempted.
+    return BytePoolBase::info(*const_cast<BytePool *>(this));
+}
+
 template <Ulong Size> auto BytePool<Size>::prioritise()
 {
     return Error{tx_byte_pool_prioritize(this)};
@@ -87,6 +134,13 @@ template <Ulong Size, Ulong BlockSize> class BlockPool : Native::TX_BLOCK_POOL,
 
     auto blockSize() const;
 
+    /// allocates a block for callers that manage its lifetime themselves. Otherwise use Allocation.
+    /// \return error and pointer to the block, nullptr on error
+    template <typename Rep = TickTimer::rep, typename Period = TickTimer::period> auto allocate(const std::chrono::duration<Rep, Period> &duration = TickTimer::noWait);
+
+    /// returns a block obtained by allocate() to its pool.
+    static auto release(std::byte *const memoryPtr);
+
     /// Places the highest priority thread suspended for memory on this pool at the front of the suspension list.
     /// All other threads remain in the same FIFO order they were suspended in.
     auto prioritise();
@@ -114,6 +168,18 @@ template <Ulong Size, Ulong BlockSize> auto BlockPool<Size, BlockSize>::blockSiz
     return tx_block_pool_block_size;
 }
 
+template <Ulong Size, Ulong BlockSize> template <typename Rep, typename Period> auto BlockPool<Size, BlockSize>::allocate(const std::chrono::duration<Rep, Period> &duration)
+{
+    std::byte *memoryPtr{};
+    Error error{tx_block_allocate(this, reinterpret_cast<void **>(std::addressof(memoryPtr)), TickTimer::ticks(duration))};
+    return std::pair{error, memoryPtr};
+}
+
+template <Ulong Size, Ulong BlockSize> auto BlockPool<Size, BlockSize>::release(std::byte *const memoryPtr)
+{
+    return Error{Native::tx_block_release(memoryPtr)};
+}
+
 template <Ulong Size, Ulong BlockSize> auto BlockPool<Size, BlockSize>::prioritise()
 {
     return Error{tx_block_pool_prioritize(this)};
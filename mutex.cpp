@@ -2,6 +2,11 @@
 #include <cassert>
 #include <string_view>
 #include <utility>
+#ifdef THREADX_MUTEX_PROFILE
+#include "kernel.hpp"
+#include <algorithm>
+#include <chrono>
+#endif
 
 namespace ThreadX
 {
@@ -14,10 +19,30 @@ Mutex::Mutex(const std::string_view name, const InheritMode inheritMode) : Nativ
     using namespace Native;
     [[maybe_unused]] Error error{tx_mutex_create(this, const_cast<char *>(name.data()), std::to_underlying(inheritMode))};
     assert(error == Error::success);
+
+#ifdef THREADX_MUTEX_PROFILE
+    Kernel::CriticalSection cs;
+    m_profiledNext = m_profiledListHead;
+    m_profiledListHead = this;
+#endif
 }
 
 Mutex::~Mutex()
 {
+#ifdef THREADX_MUTEX_PROFILE
+    {
+        Kernel::CriticalSection cs;
+        for (auto nextPtr{std::addressof(m_profiledListHead)}; *nextPtr; nextPtr = std::addressof((*nextPtr)->m_profiledNext))
+        {
+            if (*nextPtr == this)
+            {
+                *nextPtr = m_profiledNext;
+                break;
+            }
+        }
+    }
+#endif
+
     [[maybe_unused]] Error error{tx_mutex_delete(this)};
     assert(error == Error::success);
 }
@@ -32,8 +57,57 @@ Error Mutex::try_lock()
     return try_lock_for(TickTimer::noWait);
 }
 
+Error Mutex::get(const Ulong ticks)
+{
+#ifdef THREADX_MUTEX_PROFILE
+    auto threadPtr{Native::tx_thread_identify()};
+    const auto ownerPtr{tx_mutex_owner};
+    // an ISR or timer cannot wait, so its attempt is not a contention.
+    const bool contended{threadPtr and ownerPtr and ownerPtr != threadPtr};
+    const bool inheritance{contended and tx_mutex_inherit and threadPtr->tx_thread_priority < ownerPtr->tx_thread_priority};
+    const auto start{HighResClock::now()};
+
+    Error error{tx_mutex_get(this, ticks)};
+
+    // contenders that gave up update the statistics without owning the mutex, so the contended path is locked.
+    const auto now{HighResClock::now()};
+    if (contended)
+    {
+        Kernel::CriticalSection cs;
+        ++m_profile.contentions;
+        m_profile.inheritances += inheritance ? 1 : 0;
+        m_profile.timeouts += error != Error::success ? 1 : 0;
+        recordWait(threadPtr, Ulong(std::chrono::duration_cast<std::chrono::microseconds>(now - start).count()));
+    }
+
+    if (error != Error::success)
+    {
+        return error;
+    }
+
+    ++m_profile.acquisitions;
+    if (tx_mutex_ownership_count == 1)
+    {
+        m_lockTime = now;
+    }
+
+    return error;
+#else
+    return Error{tx_mutex_get(this, ticks)};
+#endif
+}
+
 Error Mutex::unlock()
 {
+#ifdef THREADX_MUTEX_PROFILE
+    if (tx_mutex_ownership_count == 1 and tx_mutex_owner == Native::tx_thread_identify())
+    {
+        const Ulong hold(std::chrono::duration_cast<std::chrono::microseconds>(HighResClock::now() - m_lockTime).count());
+        m_profile.totalHold += hold;
+        m_profile.maxHold = std::max(m_profile.maxHold, hold);
+    }
+#endif
+
     return Error{tx_mutex_put(this)};
 }
 
@@ -51,4 +125,63 @@ uintptr_t Mutex::lockingThreadID() const
 {
     return uintptr_t(tx_mutex_owner);
 }
+
+Ulong Mutex::ownershipCount() const
+{
+    return tx_mutex_ownership_count;
+}
+
+#ifdef THREADX_MUTEX_PROFILE
+const MutexProfile &Mutex::profile() const
+{
+    return m_profile;
+}
+
+void Mutex::clearProfile()
+{
+    // contended attempts update the statistics in a critical section.
+    Kernel::CriticalSection cs;
+    m_profile = {};
+}
+
+size_t Mutex::rankByWaitTime(std::span<MutexRank> ranking)
+{
+    size_t count{};
+    {
+        Kernel::CriticalSection cs;
+        for (auto mutexPtr{m_profiledListHead}; mutexPtr and count < ranking.size(); mutexPtr = mutexPtr->m_profiledNext)
+        {
+            ranking[count++] = MutexRank{.mutexPtr = mutexPtr, .totalWait = mutexPtr->m_profile.totalWait};
+        }
+    }
+
+    // the totals are copied, so the sort sees values that do not change under it, with interrupts enabled.
+    std::sort(ranking.begin(), ranking.begin() + count, [](const auto &a, const auto &b) { return a.totalWait > b.totalWait; });
+
+    return count;
+}
+
+void Mutex::recordWait(Native::TX_THREAD *const threadPtr, const Ulong waitTime)
+{
+    m_profile.totalWait += waitTime;
+    m_profile.maxWait = std::max(m_profile.maxWait, waitTime);
+
+    auto &waiters{m_profile.waiters};
+    auto waiterIt{std::find_if(waiters.begin(), waiters.end(), [threadPtr](const auto &waiter) { return waiter.threadPtr == threadPtr; })};
+    if (waiterIt == waiters.end())
+    {
+        // replace the waiter with the least total wait, if this one has waited longer already.
+        waiterIt = std::min_element(waiters.begin(), waiters.end(), [](const auto &a, const auto &b) { return a.waitTime < b.waitTime; });
+        if (waiterIt->threadPtr and waiterIt->waitTime >= waitTime)
+        {
+            return;
+        }
+
+        *waiterIt = {threadPtr, 0, 0};
+    }
+
+    ++waiterIt->waits;
+    waiterIt->waitTime += waitTime;
+}
+#endif
 } // namespace ThreadX
@@ -4,6 +4,11 @@
 #include "txCommon.hpp"
 #include <mutex>
 #include <string_view>
+#ifdef THREADX_MUTEX_PROFILE
+#include "highResClock.hpp"
+#include <array>
+#include <span>
+#endif
 
 #define tryLock() try_lock()
 #define tryLockUntil(x) try_lock_until(x)
@@ -18,6 +23,40 @@ enum class InheritMode : Uint
     inherit    ///< inherit
 };
 
+#ifdef THREADX_MUTEX_PROFILE
+/// Contention statistics of a Mutex, collected when THREADX_MUTEX_PROFILE is defined. Times are in microseconds of HighResClock.
+struct MutexProfile
+{
+    static constexpr size_t topWaiters{4};
+
+    using Waiter = struct
+    {
+        Native::TX_THREAD *threadPtr;
+        Ulong waits;
+        Ulong64 waitTime;
+    };
+
+    Ulong acquisitions;
+    Ulong contentions;  ///< lock attempts that found the mutex owned by another thread
+    Ulong timeouts;     ///< contended attempts that gave up
+    Ulong inheritances; ///< contended attempts that raised the owner's priority
+    Ulong64 totalWait;
+    Ulong maxWait;
+    Ulong64 totalHold;
+    Ulong maxHold;
+    std::array<Waiter, topWaiters> waiters; ///< threads with the longest total wait, unsorted
+};
+
+class Mutex;
+
+/// Entry of Mutex::rankByWaitTime()
+struct MutexRank
+{
+    const Mutex *mutexPtr;
+    Ulong64 totalWait; ///< at the time of the ranking
+};
+#endif
+
 /// Mutex for locking access to resources.
 class Mutex : Native::TX_MUTEX
 {
@@ -55,6 +94,31 @@ class Mutex : Native::TX_MUTEX
     Error prioritise();
 
     uintptr_t lockingThreadID() const;
+
+    /// \return number of times the owner has locked the mutex, zero if it is not locked
+    Ulong ownershipCount() const;
+
+#ifdef THREADX_MUTEX_PROFILE
+    const MutexProfile &profile() const;
+
+    void clearProfile();
+
+    /// Fills ranking with the profiled mutexes in decreasing order of total wait time.
+    /// \return number of entries filled
+    static size_t rankByWaitTime(std::span<MutexRank> ranking);
+#endif
+
+  private:
+    Error get(const Ulong ticks);
+
+#ifdef THREADX_MUTEX_PROFILE
+    void recordWait(Native::TX_THREAD *const threadPtr, const Ulong waitTime);
+
+    static inline Mutex *m_profiledListHead{};
+    Mutex *m_profiledNext{};
+    MutexProfile m_profile{};
+    HighResClock::TimePoint m_lockTime{};
+#endif
 };
 
 template <class Clock, typename Duration> auto Mutex::try_lock_until(const std::chrono::time_point<Clock, Duration> &time)
@@ -64,7 +128,7 @@ template <class Clock, typename Duration> auto Mutex::try_lock_until(const std::
 
 template <typename Rep, typename Period> auto Mutex::try_lock_for(const std::chrono::duration<Rep, Period> &duration)
 {
-    return Error{tx_mutex_get(this, TickTimer::ticks(duration))};
+    return get(TickTimer::ticks(duration));
 }
 
 using LockGuard = std::lock_guard<Mutex>;
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "histogram.hpp"
+#include "semaphore.hpp"
+#include "thread.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <string_view>
+
+namespace ThreadX
+{
+/// What a periodic task does with releases that happened while a previous job was still running.
+enum class OverrunPolicy
+{
+    skip,    ///< drop the missed releases and continue with the latest one.
+    catchUp, ///< run a job for every missed release, back to back.
+    notify   ///< drop the missed releases like skip, after calling the overrun callback with the number of them.
+};
+
+inline constexpr size_t periodicTaskHistogramBins{16};
+
+/// Thread that runs periodicCallback() on absolute release points.
+/// Releases come from a periodic TickTimer rather than from sleeping after each job, so the time spent in a job
+/// does not shift the next release and there is no cumulative drift. All times are in ticks.
+template <class Pool> class PeriodicTask : public Thread<Pool>
+{
+  public:
+    using OverrunCallback = std::function<void(PeriodicTask &, const Ulong)>;
+    using TickHistogram = Histogram<periodicTaskHistogramBins>;
+    using Statistics = struct
+    {
+        Ulong releases;       ///< number of releases by the timer
+        Ulong jobs;           ///< number of periodicCallback() calls
+        Ulong overruns;       ///< releases that found the previous job still pending or running
+        Ulong deadlineMisses; ///< jobs that finished later than release + deadline
+        TickHistogram jitter;        ///< release to start of job
+        TickHistogram executionTime; ///< start to end of job, including preemption
+    };
+
+    /// \param period release period, also the default relative deadline
+    /// \param overrunPolicy \sa OverrunPolicy
+    /// \param overrunCallback called from the task thread with the number of missed releases, if policy is notify
+    explicit PeriodicTask(const std::string_view name, Pool &pool, const Ulong stackSize, const auto &period, const OverrunPolicy overrunPolicy = OverrunPolicy::skip, const OverrunCallback &overrunCallback = {},
+                          const Uint priority = defaultPriority, const Uint preamptionThresh = defaultPriority, const ThreadStartType startType = ThreadStartType::autoStart)
+        requires(std::is_base_of_v<BytePoolBase, Pool>);
+
+    explicit PeriodicTask(const std::string_view name, Pool &pool, const auto &period, const OverrunPolicy overrunPolicy = OverrunPolicy::skip, const OverrunCallback &overrunCallback = {}, const Uint priority = defaultPriority,
+                          const Uint preamptionThresh = defaultPriority, const ThreadStartType startType = ThreadStartType::autoStart)
+        requires(std::is_base_of_v<BlockPoolBase, Pool>);
+
+    auto period() const;
+
+    /// Changes the relative deadline. Jobs finishing later than release + deadline are counted as deadline misses.
+    /// \param deadline
+    template <typename Rep, typename Period> auto deadline(const std::chrono::duration<Rep, Period> &deadline);
+
+    auto deadline() const;
+
+    /// Returns a copy of the statistics. The copy is not atomic with respect to a running job.
+    auto statistics() const;
+
+    auto resetStatistics();
+
+  protected:
+    ~PeriodicTask();
+
+  private:
+    void entryCallback() final;
+    void releaseCallback();
+    auto runJob(const Ulong release);
+
+    virtual void periodicCallback() = 0;
+
+    const Ulong m_period;
+    Ulong m_deadline;
+    const OverrunPolicy m_overrunPolicy;
+    const OverrunCallback m_overrunCallback;
+    std::atomic<Ulong> m_releases{};
+    std::atomic<Ulong> m_jobs{};
+    std::atomic<Ulong> m_overruns{};
+    Ulong m_firstRelease{};
+    Ulong m_deadlineMisses{};
+    TickHistogram m_jitter;
+    TickHistogram m_executionTime;
+    CountingSemaphore<> m_releaseSemaphore;
+    TickTimer m_releaseTimer;
+};
+
+template <class Pool>
+PeriodicTask<Pool>::PeriodicTask(const std::string_view name, Pool &pool, const Ulong stackSize, const auto &period, const OverrunPolicy overrunPolicy, const OverrunCallback &overrunCallback, const Uint priority, const Uint preamptionThresh,
+                                 const ThreadStartType startType)
+    requires(std::is_base_of_v<BytePoolBase, Pool>)
+    : Thread<Pool>{name, pool, stackSize, {}, priority, preamptionThresh, noTimeSlice, ThreadStartType::dontStart}, m_period{TickTimer::ticks(period)}, m_deadline{m_period}, m_overrunPolicy{overrunPolicy},
+      m_overrunCallback{overrunCallback}, m_releaseSemaphore{name}, m_releaseTimer{name, period, [this](auto) { releaseCallback(); }, TickTimer::Type::periodicImmediate, TickTimer::ActivationType::noActivate}
+{
+    assert(m_period > 0);
+
+    // the thread is created suspended so that it cannot run before the members above are constructed.
+    if (startType == ThreadStartType::autoStart)
+    {
+        [[maybe_unused]] auto error{this->resume()};
+        assert(error == Error::success);
+    }
+}
+
+template <class Pool>
+PeriodicTask<Pool>::PeriodicTask(const std::string_view name, Pool &pool, const auto &period, const OverrunPolicy overrunPolicy, const OverrunCallback &overrunCallback, const Uint priority, const Uint preamptionThresh,
+                                 const ThreadStartType startType)
+    requires(std::is_base_of_v<BlockPoolBase, Pool>)
+    : Thread<Pool>{name, pool, {}, priority, preamptionThresh, noTimeSlice, ThreadStartType::dontStart}, m_period{TickTimer::ticks(period)}, m_deadline{m_period}, m_overrunPolicy{overrunPolicy}, m_overrunCallback{overrunCallback},
+      m_releaseSemaphore{name}, m_releaseTimer{name, period, [this](auto) { releaseCallback(); }, TickTimer::Type::periodicImmediate, TickTimer::ActivationType::noActivate}
+{
+    assert(m_period > 0);
+
+    // the thread is created suspended so that it cannot run before the members above are constructed.
+    if (startType == ThreadStartType::autoStart)
+    {
+        [[maybe_unused]] auto error{this->resume()};
+        assert(error == Error::success);
+    }
+}
+
+template <class Pool> PeriodicTask<Pool>::~PeriodicTask()
+{
+    // stop the job loop before the release timer and semaphore it waits on are deleted.
+    [[maybe_unused]] Error error{m_releaseTimer.deactivate()};
+    assert(error == Error::success);
+
+    error = this->terminate();
+    assert(error == Error::success);
+}
+
+template <class Pool> auto PeriodicTask<Pool>::period() const
+{
+    return TickTimer::Duration{m_period};
+}
+
+template <class Pool> template <typename Rep, typename Period> auto PeriodicTask<Pool>::deadline(const std::chrono::duration<Rep, Period> &deadline)
+{
+    m_deadline = TickTimer::ticks(deadline);
+}
+
+template <class Pool> auto PeriodicTask<Pool>::deadline() const
+{
+    return TickTimer::Duration{m_deadline};
+}
+
+template <class Pool> auto PeriodicTask<Pool>::statistics() const
+{
+    return Statistics{.releases = m_releases.load(),
+                      .jobs = m_jobs.load(),
+                      .overruns = m_overruns.load(),
+                      .deadlineMisses = m_deadlineMisses,
+                      .jitter = m_jitter,
+                      .executionTime = m_executionTime};
+}
+
+template <class Pool> auto PeriodicTask<Pool>::resetStatistics()
+{
+    m_overruns = 0;
+    m_deadlineMisses = 0;
+    m_jitter.clear();
+    m_executionTime.clear();
+}
+
+template <class Pool> void PeriodicTask<Pool>::entryCallback()
+{
+    [[maybe_unused]] auto error{m_releaseTimer.activate()};
+    assert(error == Error::success);
+
+    while (true)
+    {
+        if (m_releaseSemaphore.acquire() != Error::success)
+        {
+            continue;
+        }
+
+        const auto releases{m_releases.load()};
+        auto jobs{m_jobs.load()};
+
+        // releases - jobs - 1 of the outstanding releases are older than the one just acquired.
+        if (const auto missed{releases - jobs - 1}; missed > 0 and m_overrunPolicy != OverrunPolicy::catchUp)
+        {
+            for (auto count{missed}; count > 0; --count)
+            {
+                [[maybe_unused]] auto dropped{m_releaseSemaphore.tryAcquire()};
+            }
+
+            jobs += missed;
+            m_jobs = jobs;
+
+            if (m_overrunPolicy == OverrunPolicy::notify and m_overrunCallback)
+            {
+                m_overrunCallback(*this, missed);
+            }
+        }
+
+        runJob(m_firstRelease + jobs * m_period);
+    }
+}
+
+template <class Pool> auto PeriodicTask<Pool>::runJob(const Ulong release)
+{
+    const Ulong start{TickTimer::now().time_since_epoch().count()};
+    m_jitter.insert(start - release);
+
+    periodicCallback();
+
+    const Ulong end{TickTimer::now().time_since_epoch().count()};
+    m_executionTime.insert(end - start);
+
+    if (end - release > m_deadline)
+    {
+        ++m_deadlineMisses;
+    }
+
+    ++m_jobs;
+}
+
+template <class Pool> void PeriodicTask<Pool>::releaseCallback()
+{
+    const auto releases{m_releases.load()};
+    if (releases == 0)
+    {
+        m_firstRelease = TickTimer::now().time_since_epoch().count();
+    }
+    else if (releases != m_jobs.load())
+    {
+        ++m_overruns;
+    }
+
+    ++m_releases;
+
+    [[maybe_unused]] auto error{m_releaseSemaphore.release()};
+    assert(error == Error::success);
+}
+} // namespace ThreadX
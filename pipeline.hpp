@@ -0,0 +1,296 @@
+#pragma once
+
+#include "highResClock.hpp"
+#include "memoryPool.hpp"
+#include "queue.hpp"
+#include "thread.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace ThreadX
+{
+/// Counters of a pipeline stage. Times are in microseconds of HighResClock, summed over the stage's threads.
+struct PipelineStageMetrics
+{
+    Ulong items;         ///< items the stage passed on
+    Ulong dropped;       ///< items the stage function rejected
+    Ulong queueDepth;    ///< items in the input queue
+    Ulong maxQueueDepth; ///< highest input queue depth seen after a send
+    Ulong64 processingTime;
+    Ulong64 inputBlockedTime;  ///< time waiting for an item
+    Ulong64 outputBlockedTime; ///< time waiting for room in the next stage's queue
+};
+
+/// Chain of stages, each a function that processes an item in place, connected by bounded queues. A full queue blocks
+/// the stage in front of it, so a slow stage holds back the ones before it rather than losing items. The metrics show
+/// which stage is the bottleneck: it is the one with the least blocked time, and the queue in front of it is full.
+/// A stage either gets its own threads and input queue, or is fused onto the threads of the stage before it, which saves
+/// a queue transfer and a context switch per item when the stage is short.
+/// \tparam Item item type, copied through the queues. Typically a pointer or a small descriptor.
+/// \tparam Pool byte pool for the queues and the thread stacks
+/// \tparam MaxStages
+/// \tparam MaxThreads threads of all stages together
+template <typename Item, class Pool, size_t MaxStages = 8, size_t MaxThreads = 8> class Pipeline
+{
+    static_assert(std::is_base_of_v<BytePoolBase, Pool>);
+
+  public:
+    /// processes an item in place.
+    /// \return false to drop the item. The first stage is called with a default item to fill, false if there is none.
+    /// The first stage may block until there is an item; if it returns false instead, it is called again a tick later.
+    using StageFunction = std::function<bool(Item &)>;
+
+    explicit Pipeline(Pool &pool);
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    /// appends a stage with its own input queue, except for the first stage.
+    /// \param name stage name, also the name of its threads and queue
+    /// \param threads threads that run the stage concurrently. Items may overtake each other with more than one.
+    Pipeline &stage(const std::string_view name, const StageFunction &function, const Uint threads = 1, const Uint priority = defaultPriority);
+
+    /// appends a stage that runs on the threads of the stage before it, with no queue in between.
+    Pipeline &fuse(const std::string_view name, const StageFunction &function);
+
+    /// creates the queues and threads. Stages cannot be appended afterwards.
+    /// \param queueCapacity items every queue holds
+    void start(const Ulong queueCapacity, const Ulong stackSize = minimumStackSize);
+
+    /// \return number of stages
+    size_t stages() const;
+
+    std::string_view name(const size_t stage) const;
+
+    PipelineStageMetrics metrics(const size_t stage) const;
+
+    void resetMetrics();
+
+  private:
+    struct Stage
+    {
+        std::string_view name;
+        StageFunction function;
+        Uint threads; // zero if fused onto the stage before
+        Uint priority;
+        std::atomic<Ulong> items;
+        std::atomic<Ulong> dropped;
+        std::atomic<Ulong> maxQueueDepth;
+        std::atomic<Ulong64> processingTime;
+        std::atomic<Ulong64> inputBlockedTime;
+        std::atomic<Ulong64> outputBlockedTime;
+    };
+
+    class Worker : public Thread<Pool>
+    {
+      public:
+        explicit Worker(Pipeline &pipeline, const size_t stage, Pool &pool, const Ulong stackSize);
+
+      private:
+        void entryCallback() final;
+
+        Pipeline &m_pipeline;
+        const size_t m_stage;
+    };
+
+    /// runs the stage and the ones fused onto it.
+    [[noreturn]] void run(const size_t stage);
+
+    /// \return index of the stage after the one that ends at stage, and with it its queue, stages() if there is none
+    size_t nextQueue(const size_t stage) const;
+
+    /// \return microseconds since start
+    static Ulong64 elapsed(const HighResClock::TimePoint start);
+
+    Pool &m_pool;
+    std::array<Stage, MaxStages> m_stages{};
+    size_t m_stageCount{};
+    std::array<std::optional<Queue<Item, Pool>>, MaxStages> m_queues; // input queue of every stage that is not fused
+    std::array<std::optional<Worker>, MaxThreads> m_workers;
+    size_t m_workerCount{};
+};
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> Pipeline<Item, Pool, MaxStages, MaxThreads>::Pipeline(Pool &pool) : m_pool{pool}
+{
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads>
+auto Pipeline<Item, Pool, MaxStages, MaxThreads>::stage(const std::string_view name, const StageFunction &function, const Uint threads, const Uint priority) -> Pipeline &
+{
+    assert(m_workerCount == 0 and m_stageCount < MaxStages and threads > 0);
+
+    auto &stage{m_stages[m_stageCount++]};
+    stage.name = name;
+    stage.function = function;
+    stage.threads = threads;
+    stage.priority = priority;
+    return *this;
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads>
+auto Pipeline<Item, Pool, MaxStages, MaxThreads>::fuse(const std::string_view name, const StageFunction &function) -> Pipeline &
+{
+    assert(m_workerCount == 0 and m_stageCount > 0 and m_stageCount < MaxStages);
+
+    auto &stage{m_stages[m_stageCount++]};
+    stage.name = name;
+    stage.function = function;
+    stage.threads = 0;
+    return *this;
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> void Pipeline<Item, Pool, MaxStages, MaxThreads>::start(const Ulong queueCapacity, const Ulong stackSize)
+{
+    assert(m_workerCount == 0 and m_stageCount > 0);
+
+    // the queues are created first, so that no thread can send to a queue that does not exist yet.
+    for (size_t stage{1}; stage < m_stageCount; ++stage)
+    {
+        if (m_stages[stage].threads > 0)
+        {
+            m_queues[stage].emplace(m_stages[stage].name, m_pool, queueCapacity);
+        }
+    }
+
+    for (size_t stage{}; stage < m_stageCount; ++stage)
+    {
+        for (Uint thread{}; thread < m_stages[stage].threads; ++thread)
+        {
+            assert(m_workerCount < MaxThreads);
+            m_workers[m_workerCount++].emplace(*this, stage, m_pool, stackSize);
+        }
+    }
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> size_t Pipeline<Item, Pool, MaxStages, MaxThreads>::stages() const
+{
+    return m_stageCount;
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> std::string_view Pipeline<Item, Pool, MaxStages, MaxThreads>::name(const size_t stage) const
+{
+    return m_stages[stage].name;
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> PipelineStageMetrics Pipeline<Item, Pool, MaxStages, MaxThreads>::metrics(const size_t stage) const
+{
+    const auto &state{m_stages[stage]};
+    return PipelineStageMetrics{.items = state.items,
+                                .dropped = state.dropped,
+                                .queueDepth = m_queues[stage] ? Ulong{m_queues[stage]->count()} : 0UL,
+                                .maxQueueDepth = state.maxQueueDepth,
+                                .processingTime = state.processingTime,
+                                .inputBlockedTime = state.inputBlockedTime,
+                                .outputBlockedTime = state.outputBlockedTime};
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> void Pipeline<Item, Pool, MaxStages, MaxThreads>::resetMetrics()
+{
+    for (auto &stage : m_stages)
+    {
+        stage.items = 0;
+        stage.dropped = 0;
+        stage.maxQueueDepth = 0;
+        stage.processingTime = 0;
+        stage.inputBlockedTime = 0;
+        stage.outputBlockedTime = 0;
+    }
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads>
+Pipeline<Item, Pool, MaxStages, MaxThreads>::Worker::Worker(Pipeline &pipeline, const size_t stage, Pool &pool, const Ulong stackSize)
+    : Thread<Pool>{pipeline.m_stages[stage].name, pool, stackSize, {}, pipeline.m_stages[stage].priority, pipeline.m_stages[stage].priority, noTimeSlice, ThreadStartType::dontStart}, m_pipeline{pipeline},
+      m_stage{stage}
+{
+    // the thread is created suspended so that it cannot run before m_pipeline and m_stage are set.
+    [[maybe_unused]] auto error{this->resume()};
+    assert(error == Error::success);
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> void Pipeline<Item, Pool, MaxStages, MaxThreads>::Worker::entryCallback()
+{
+    m_pipeline.run(m_stage);
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> void Pipeline<Item, Pool, MaxStages, MaxThreads>::run(const size_t stage)
+{
+    auto &input{m_queues[stage]};
+    const auto next{nextQueue(stage)};
+    auto &output{m_queues[next < m_stageCount ? next : 0]};
+
+    while (true)
+    {
+        Item item{};
+        if (input)
+        {
+            const auto start{HighResClock::now()};
+            auto [error, message]{input->receive()};
+            assert(error == Error::success);
+            m_stages[stage].inputBlockedTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+            item = message;
+        }
+
+        auto passed{true};
+        auto current{stage};
+        for (; current < next and passed; ++current)
+        {
+            auto &state{m_stages[current]};
+            const auto start{HighResClock::now()};
+            passed = state.function(item);
+            state.processingTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+            (passed ? state.items : state.dropped).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (not input and not passed and current == stage + 1)
+        {
+            // the source has no item. Waiting a tick keeps it from spinning and starving lower priority threads.
+            const auto start{HighResClock::now()};
+            [[maybe_unused]] auto error{ThisThread::sleepFor(TickTimer::Duration{1})};
+            assert(error == Error::success);
+            m_stages[stage].inputBlockedTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+        }
+
+        if (not passed or next == m_stageCount)
+        {
+            continue;
+        }
+
+        if (output->trySend(item) != Error::success)
+        {
+            const auto start{HighResClock::now()};
+            [[maybe_unused]] auto error{output->send(item)};
+            assert(error == Error::success);
+            m_stages[next - 1].outputBlockedTime.fetch_add(elapsed(start), std::memory_order_relaxed);
+        }
+
+        auto &maxQueueDepth{m_stages[next].maxQueueDepth};
+        for (Ulong depth{output->count()}, max{maxQueueDepth.load(std::memory_order_relaxed)}; depth > max and not maxQueueDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed);)
+        {
+        }
+    }
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> size_t Pipeline<Item, Pool, MaxStages, MaxThreads>::nextQueue(const size_t stage) const
+{
+    auto next{stage + 1};
+    while (next < m_stageCount and m_stages[next].threads == 0)
+    {
+        ++next;
+    }
+
+    return next;
+}
+
+template <typename Item, class Pool, size_t MaxStages, size_t MaxThreads> Ulong64 Pipeline<Item, Pool, MaxStages, MaxThreads>::elapsed(const HighResClock::TimePoint start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(HighResClock::now() - start).count();
+}
+} // namespace ThreadX
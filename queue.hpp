@@ -79,6 +79,9 @@ template <typename Msg, class Pool> class Queue : Native::TX_QUEUE
 
     auto name() const;
 
+    /// \return number of messages in the queue
+    auto count() const;
+
   private:
     static auto sendNotifyCallback(auto queuePtr);
     auto init(const std::string_view name, const Ulong queueSizeInBytes);
@@ -219,6 +222,11 @@ template <typename Msg, class Pool> auto Queue<Msg, Pool>::name() const
     return std::string_view{tx_queue_name};
 }
 
+template <typename Msg, class Pool> auto Queue<Msg, Pool>::count() const
+{
+    return tx_queue_enqueued;
+}
+
 template <typename Msg, class Pool> auto Queue<Msg, Pool>::sendNotifyCallback(auto queuePtr)
 {
     auto &queue{static_cast<Queue &>(*queuePtr)};
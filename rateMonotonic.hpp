@@ -0,0 +1,297 @@
+#pragma once
+
+// This file has no ThreadX dependency so that the host-side tools can use it as well.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ThreadX::RateMonotonic
+{
+/// Any time unit, as long as all tasks of an analysis use the same one.
+using Time = std::uint64_t;
+
+struct Task
+{
+    std::string name;
+    Time period;                 ///< minimum inter-activation time
+    Time wcet;                   ///< worst-case execution time
+    Time blocking{};             ///< worst-case blocking on resources shared with lower priority tasks
+    Time deadline{};             ///< relative deadline, zero means equal to period
+    unsigned priority{};         ///< ThreadX priority in use, zero is the highest
+    unsigned threshold{};        ///< ThreadX preemption-threshold in use
+    std::uint64_t preemptions{}; ///< measured preemptions, zero if not known
+};
+
+struct TaskResult
+{
+    size_t index; ///< of the task in the task set given to analyse()
+    std::string name;
+    Time period;
+    Time deadline;
+    Time responseTime; ///< Time(-1) when unbounded
+    bool schedulable;
+    unsigned priority;                 ///< suggested priority
+    unsigned threshold;                ///< highest safe preemption-threshold
+    double preemptionsPerJob;          ///< estimated with threshold equal to priority
+    double thresholdPreemptionsPerJob; ///< estimated with the suggested threshold
+    std::uint64_t measuredPreemptions;
+    std::uint64_t expectedPreemptions; ///< measured preemptions scaled by the estimated reduction
+};
+
+struct Report
+{
+    std::vector<TaskResult> tasks;
+    double utilisation;
+    bool schedulable;
+    double contextSwitchRate;          ///< estimated context switches per time unit with thresholds equal to priorities
+    double thresholdContextSwitchRate; ///< estimated context switches per time unit with the suggested thresholds
+};
+
+namespace Detail
+{
+struct Entry
+{
+    Time period;
+    Time wcet;
+    Time blocking;
+    Time deadline;
+    size_t threshold; // rank of the threshold, 0 is the highest priority.
+};
+
+inline Time ceilDiv(const Time a, const Time b)
+{
+    return (a + b - 1) / b;
+}
+
+struct Window
+{
+    Time responseTime;
+    Time start;
+    Time finish;
+    bool schedulable;
+};
+
+/// Response time analysis with preemption-thresholds (Wang and Saksena, 1999). Tasks are sorted by priority.
+inline Window responseTime(const std::vector<Entry> &entries, const size_t task)
+{
+    const auto &self{entries[task]};
+    const auto limit{self.deadline};
+
+    // a lower priority task blocks us if we cannot preempt it once it started.
+    Time blocking{self.blocking};
+    for (auto lower{task + 1}; lower < entries.size(); ++lower)
+    {
+        if (entries[lower].threshold <= task)
+        {
+            blocking = std::max(blocking, entries[lower].wcet);
+        }
+    }
+
+    // level-i busy period, which only ends if the tasks down to this one leave the processor idle at some point.
+    Time busy{blocking};
+    double utilisation{};
+    for (size_t j{}; j <= task; ++j)
+    {
+        busy += entries[j].wcet;
+        utilisation += double(entries[j].wcet) / double(entries[j].period);
+    }
+
+    if (utilisation > 1.0 or (utilisation == 1.0 and blocking > 0))
+    {
+        return {Time(-1), 0, Time(-1), false};
+    }
+
+    for (Time previous{}; busy != previous;)
+    {
+        previous = busy;
+        busy = blocking;
+        for (size_t j{}; j <= task; ++j)
+        {
+            busy += ceilDiv(previous, entries[j].period) * entries[j].wcet;
+        }
+    }
+
+    Window worst{0, 0, 0, true};
+    for (Time job{}; job < ceilDiv(busy, self.period); ++job)
+    {
+        // start time: blocked, then preempted by all higher priority tasks.
+        Time start{blocking + job * self.wcet};
+        for (size_t j{}; j < task; ++j)
+        {
+            start += entries[j].wcet;
+        }
+
+        for (Time previous{}; start != previous;)
+        {
+            previous = start;
+            start = blocking + job * self.wcet;
+            for (size_t j{}; j < task; ++j)
+            {
+                start += (1 + previous / entries[j].period) * entries[j].wcet;
+            }
+
+            if (start > job * self.period + limit)
+            {
+                return {start, start, start, false};
+            }
+        }
+
+        // finish time: once started, only tasks above our threshold can preempt.
+        Time finish{start + self.wcet};
+        for (Time previous{}; finish != previous;)
+        {
+            previous = finish;
+            finish = start + self.wcet;
+            for (size_t j{}; j < self.threshold; ++j)
+            {
+                const auto releases{ceilDiv(previous, entries[j].period)};
+                const auto before{1 + start / entries[j].period};
+                finish += (releases > before ? releases - before : 0) * entries[j].wcet;
+            }
+
+            if (finish > job * self.period + limit)
+            {
+                return {finish, start, finish, false};
+            }
+        }
+
+        if (finish - job * self.period >= worst.responseTime)
+        {
+            worst = {finish - job * self.period, start, finish, true};
+        }
+    }
+
+    return worst;
+}
+
+inline bool schedulable(const std::vector<Entry> &entries)
+{
+    for (size_t task{}; task < entries.size(); ++task)
+    {
+        if (auto window{responseTime(entries, task)}; not window.schedulable or window.responseTime > entries[task].deadline)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Expected number of releases of tasks above the threshold while a job executes, each of which preempts it.
+/// This is an average over release phasings, using the worst-case execution window.
+inline double preemptionsPerJob(const std::vector<Entry> &entries, const size_t task)
+{
+    const auto window{responseTime(entries, task)};
+    double preemptions{};
+    for (size_t j{}; j < entries[task].threshold; ++j)
+    {
+        preemptions += double(window.finish - window.start) / double(entries[j].period);
+    }
+
+    return preemptions;
+}
+
+/// Each job costs a switch in and out, and each preemption another two.
+inline double contextSwitchRate(const std::vector<Entry> &entries)
+{
+    double rate{};
+    for (size_t task{}; task < entries.size(); ++task)
+    {
+        rate += (2.0 + 2.0 * preemptionsPerJob(entries, task)) / double(entries[task].period);
+    }
+
+    return rate;
+}
+} // namespace Detail
+
+/// Assigns deadline-monotonic priorities (rate-monotonic when deadlines equal periods), runs a response time analysis,
+/// and raises each preemption-threshold as far as all tasks stay schedulable.
+/// \param tasks observed or specified task set
+/// \param highestPriority ThreadX priority given to the most urgent task
+/// \param priorityStep gap between consecutive suggested priorities, to leave room for other threads
+/// \return results in priority order, without the tasks that have no period
+inline Report analyse(std::vector<Task> tasks, const unsigned highestPriority = 1, const unsigned priorityStep = 1)
+{
+    // indexes of the tasks in priority order.
+    std::vector<size_t> order;
+    for (size_t index{}; index < tasks.size(); ++index)
+    {
+        auto &task{tasks[index]};
+        if (task.period == 0)
+        {
+            continue;
+        }
+
+        if (task.deadline == 0 or task.deadline > task.period)
+        {
+            task.deadline = task.period;
+        }
+
+        order.push_back(index);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&tasks](const auto a, const auto b) { return tasks[a].deadline < tasks[b].deadline; });
+
+    std::vector<Detail::Entry> entries;
+    double utilisation{};
+    for (size_t rank{}; rank < order.size(); ++rank)
+    {
+        const auto &task{tasks[order[rank]]};
+        entries.push_back({task.period, task.wcet, task.blocking, task.deadline, rank});
+        utilisation += double(task.wcet) / double(task.period);
+    }
+
+    Report report{{}, utilisation, utilisation <= 1.0 and Detail::schedulable(entries), 0.0, 0.0};
+
+    std::vector<double> preemptions(entries.size());
+    if (report.schedulable)
+    {
+        report.contextSwitchRate = Detail::contextSwitchRate(entries);
+        for (size_t task{}; task < entries.size(); ++task)
+        {
+            preemptions[task] = Detail::preemptionsPerJob(entries, task);
+        }
+
+        // raising a threshold can only hurt the tasks it blocks, so keep going while the whole set stays schedulable.
+        for (size_t task{}; task < entries.size(); ++task)
+        {
+            while (entries[task].threshold > 0)
+            {
+                --entries[task].threshold;
+                if (not Detail::schedulable(entries))
+                {
+                    ++entries[task].threshold;
+                    break;
+                }
+            }
+        }
+
+        report.thresholdContextSwitchRate = Detail::contextSwitchRate(entries);
+    }
+
+    for (size_t task{}; task < entries.size(); ++task)
+    {
+        const auto window{Detail::responseTime(entries, task)};
+        const auto after{report.schedulable ? Detail::preemptionsPerJob(entries, task) : 0.0};
+        const auto scale{preemptions[task] > 0.0 ? after / preemptions[task] : 1.0};
+        const auto &input{tasks[order[task]]};
+
+        report.tasks.push_back({.index = order[task],
+                                .name = input.name,
+                                .period = input.period,
+                                .deadline = input.deadline,
+                                .responseTime = window.responseTime,
+                                .schedulable = window.schedulable and window.responseTime <= input.deadline,
+                                .priority = highestPriority + unsigned(task) * priorityStep,
+                                .threshold = highestPriority + unsigned(entries[task].threshold) * priorityStep,
+                                .preemptionsPerJob = preemptions[task],
+                                .thresholdPreemptionsPerJob = after,
+                                .measuredPreemptions = input.preemptions,
+                                .expectedPreemptions = std::uint64_t(double(input.preemptions) * scale)});
+    }
+
+    return report;
+}
+} // namespace ThreadX::RateMonotonic
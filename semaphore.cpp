@@ -1,5 +1,7 @@
 #include "semaphore.hpp"
+#include "kernel.hpp"
 #include <cassert>
+#include <utility>
 
 namespace ThreadX
 {
@@ -13,18 +15,186 @@ CountingSemaphoreBase::~CountingSemaphoreBase()
     assert(error == Error::success);
 }
 
-Error CountingSemaphoreBase::release(Ulong count)
+Error CountingSemaphoreBase::release(Ulong count, Ulong &added)
 {
+    added = 0;
+
+    // a single instance goes through the kernel service, with its error checking, trace events and performance counters.
+    if (count == 1)
+    {
+        Error error{tx_semaphore_ceiling_put(this, m_ceiling)};
+        grantWaiters();
+        return error;
+    }
+
+    // resumed threads may not preempt us before all instances are released. ISRs are not preempted by threads anyway.
+    auto threadPtr{Kernel::inIsr() ? nullptr : Native::tx_thread_identify()};
+    Uint preemption{};
+    bool preemptionChanged{};
+
+    Error error{Error::success};
     while (count > 0)
     {
-        if (Error error{tx_semaphore_ceiling_put(this, m_ceiling)}; error != Error::success)
         {
-            return error;
+            Kernel::CriticalSection cs;
+            if (tx_semaphore_suspended_count == 0)
+            {
+                if (count > m_ceiling or tx_semaphore_count > m_ceiling - count)
+                {
+                    error = Error::ceilingExceeded;
+                    break;
+                }
+
+                tx_semaphore_count += count;
+                added = count;
+                break;
+            }
+        }
+
+        if (threadPtr and not preemptionChanged)
+        {
+            preemptionChanged = Error{Native::tx_thread_preemption_change(threadPtr, 0, std::addressof(preemption))} == Error::success;
+        }
+
+        if (error = Error{tx_semaphore_ceiling_put(this, m_ceiling)}; error != Error::success)
+        {
+            break;
         }
 
         --count;
     }
 
-    return Error::success;
+    grantWaiters();
+
+    if (preemptionChanged)
+    {
+        Uint oldPreemption{};
+        [[maybe_unused]] Error restoreError{Native::tx_thread_preemption_change(threadPtr, preemption, std::addressof(oldPreemption))};
+        assert(restoreError == Error::success);
+    }
+
+    return error;
+}
+
+Error CountingSemaphoreBase::acquire(const Ulong count, const Ulong ticks)
+{
+    if (count > m_ceiling)
+    {
+        return Error::ceilingExceeded;
+    }
+
+    auto take = [this, count]() {
+        // queued waiters are served first, in order.
+        if (m_waitersHead or tx_semaphore_count < count)
+        {
+            return false;
+        }
+
+        tx_semaphore_count -= count;
+        return true;
+    };
+
+    {
+        Kernel::CriticalSection cs;
+        if (take())
+        {
+            return Error::success;
+        }
+    }
+
+    if (ticks == TickTimer::noWait.count())
+    {
+        return Error::noInstance;
+    }
+
+    // the semaphore is created before the waiter is queued, as release() may put it as soon as it is.
+    Waiter waiter{.count = count, .granted = false, .nextPtr = nullptr, .semaphore = {}};
+    [[maybe_unused]] Error error{tx_semaphore_create(std::addressof(waiter.semaphore), const_cast<char *>("acquire"), 0)};
+    assert(error == Error::success);
+
+    bool queued{};
+    {
+        Kernel::CriticalSection cs;
+        if (not take())
+        {
+            (m_waitersTail ? m_waitersTail->nextPtr : m_waitersHead) = std::addressof(waiter);
+            m_waitersTail = std::addressof(waiter);
+            queued = true;
+        }
+    }
+
+    if (queued)
+    {
+        if (error = Error{tx_semaphore_get(std::addressof(waiter.semaphore), ticks)}; error != Error::success)
+        {
+            bool granted{};
+            {
+                Kernel::CriticalSection cs;
+                granted = waiter.granted;
+                if (not granted)
+                {
+                    unlink(waiter);
+                }
+            }
+
+            if (granted)
+            {
+                // granted just after the wait ended: the put is on its way, and must be taken before the delete.
+                error = Error{tx_semaphore_get(std::addressof(waiter.semaphore), TX_WAIT_FOREVER)};
+                assert(error == Error::success);
+            }
+            else
+            {
+                // the waiters behind this one may fit now.
+                grantWaiters();
+            }
+        }
+    }
+
+    [[maybe_unused]] Error deleteError{tx_semaphore_delete(std::addressof(waiter.semaphore))};
+    assert(deleteError == Error::success);
+    return error;
+}
+
+void CountingSemaphoreBase::grantWaiters()
+{
+    while (true)
+    {
+        Waiter *waiterPtr{};
+        {
+            Kernel::CriticalSection cs;
+            waiterPtr = m_waitersHead;
+            if (not waiterPtr or waiterPtr->count > tx_semaphore_count)
+            {
+                return;
+            }
+
+            tx_semaphore_count -= waiterPtr->count;
+            waiterPtr->granted = true;
+            unlink(*waiterPtr);
+        }
+
+        // the waiter may run and return as soon as its semaphore is put, so it is not touched afterwards.
+        [[maybe_unused]] Error error{tx_semaphore_put(std::addressof(waiterPtr->semaphore))};
+        assert(error == Error::success);
+    }
+}
+
+void CountingSemaphoreBase::unlink(Waiter &waiter)
+{
+    Waiter *previousPtr{};
+    for (auto waiterPtr{m_waitersHead}; waiterPtr; previousPtr = std::exchange(waiterPtr, waiterPtr->nextPtr))
+    {
+        if (waiterPtr == std::addressof(waiter))
+        {
+            (previousPtr ? previousPtr->nextPtr : m_waitersHead) = waiter.nextPtr;
+            if (m_waitersTail == waiterPtr)
+            {
+                m_waitersTail = previousPtr;
+            }
+
+            return;
+        }
+    }
 }
 } // namespace ThreadX
@@ -13,10 +13,30 @@ class CountingSemaphoreBase : protected Native::TX_SEMAPHORE
     explicit CountingSemaphoreBase(const Ulong ceiling);
     ~CountingSemaphoreBase();
 
-    Error release(Ulong count);
+    /// \param added set to the number of units added to the count directly, which the kernel put notify callback does not see
+    Error release(Ulong count, Ulong &added);
+
+    Error acquire(const Ulong count, const Ulong ticks);
 
   private:
+    /// thread waiting in acquire() for count instances, queued in FIFO order. release() takes the instances from the
+    /// count for it and puts its semaphore.
+    struct Waiter
+    {
+        Ulong count;
+        bool granted;
+        Waiter *nextPtr;
+        Native::TX_SEMAPHORE semaphore;
+    };
+
+    /// hands instances in the count to the waiters at the front of the queue for as long as the first one's fit.
+    void grantWaiters();
+
+    void unlink(Waiter &waiter);
+
     Ulong m_ceiling;
+    Waiter *m_waitersHead{};
+    Waiter *m_waitersTail{};
 };
 
 template <Ulong Ceiling = std::numeric_limits<Ulong>::max()> class CountingSemaphore : CountingSemaphoreBase
@@ -44,9 +64,32 @@ template <Ulong Ceiling = std::numeric_limits<Ulong>::max()> class CountingSemap
     /// \param duration
     template <typename Rep, typename Period> auto tryAcquireFor(const std::chrono::duration<Rep, Period> &duration);
 
+    /// retrieves count instances at once. Threads acquiring several instances wait in FIFO order, and a thread is given
+    /// all of its instances together when they are available, so none of them holds part of its instances while it waits.
+    /// The first waiter holds back the ones behind it, even those that would fit, so large requests are not starved by
+    /// small ones. Single instance acquire() calls do not queue behind them.
+    auto acquire(const Ulong count)
+        requires(Ceiling > 1);
+
+    auto tryAcquire(const Ulong count)
+        requires(Ceiling > 1);
+
+    template <class Clock, typename Duration>
+    auto tryAcquireUntil(const Ulong count, const std::chrono::time_point<Clock, Duration> &time)
+        requires(Ceiling > 1);
+
+    /// \param count number of instances, up to max()
+    /// \param duration
+    template <typename Rep, typename Period>
+    auto tryAcquireFor(const Ulong count, const std::chrono::duration<Rep, Period> &duration)
+        requires(Ceiling > 1);
+
     ///  puts an instance into the specified counting semaphore, which in reality increments the counting semaphore by
     ///  one. If the counting semaphore's current value is greater than or equal to the specified ceiling, the instance
     ///  will not be put and a TX_CEILING_EXCEEDED error will be returned.
+    ///  A single instance is put with tx_semaphore_ceiling_put. Several instances are released at once: with no thread
+    ///  waiting they are added to the count in one step, bypassing the kernel's trace and performance counters, otherwise
+    ///  the waiting threads are resumed without being able to preempt the caller until all instances are released.
     /// \param count
     auto release(const Ulong count = 1);
 
@@ -108,9 +151,48 @@ template <Ulong Ceiling> template <typename Rep, typename Period> auto CountingS
     return Error{tx_semaphore_get(this, TickTimer::ticks(duration))};
 }
 
+template <Ulong Ceiling>
+auto CountingSemaphore<Ceiling>::acquire(const Ulong count)
+    requires(Ceiling > 1)
+{
+    return tryAcquireFor(count, TickTimer::waitForever);
+}
+
+template <Ulong Ceiling>
+auto CountingSemaphore<Ceiling>::tryAcquire(const Ulong count)
+    requires(Ceiling > 1)
+{
+    return tryAcquireFor(count, TickTimer::noWait);
+}
+
+template <Ulong Ceiling>
+template <class Clock, typename Duration>
+auto CountingSemaphore<Ceiling>::tryAcquireUntil(const Ulong count, const std::chrono::time_point<Clock, Duration> &time)
+    requires(Ceiling > 1)
+{
+    return tryAcquireFor(count, time - Clock::now());
+}
+
+template <Ulong Ceiling>
+template <typename Rep, typename Period>
+auto CountingSemaphore<Ceiling>::tryAcquireFor(const Ulong count, const std::chrono::duration<Rep, Period> &duration)
+    requires(Ceiling > 1)
+{
+    return CountingSemaphoreBase::acquire(count, TickTimer::ticks(duration));
+}
+
 template <Ulong Ceiling> auto CountingSemaphore<Ceiling>::release(const Ulong count)
 {
-    return CountingSemaphoreBase::release(count);
+    Ulong added{};
+    Error error{CountingSemaphoreBase::release(count, added)};
+
+    // instances added directly to the count bypass the kernel, so the callback is called once for all of them.
+    if (added > 0 and m_releaseNotifyCallback)
+    {
+        m_releaseNotifyCallback(*this);
+    }
+
+    return error;
 }
 
 template <Ulong Ceiling> auto CountingSemaphore<Ceiling>::prioritise()
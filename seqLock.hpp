@@ -0,0 +1,114 @@
+#pragma once
+
+#include "kernel.hpp"
+#include "txCommon.hpp"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace ThreadX
+{
+/// Sequence lock for small trivially copyable data. Readers never block the writer: they copy the data and retry if a
+/// write happened meanwhile. Writes run in a Kernel::CriticalSection, so a reader is only retried when an interrupt
+/// writes while it copies. Both sides can be used from threads, timers and ISRs.
+/// \tparam T data type, kept small since it is copied with interrupts disabled
+template <typename T> class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+  public:
+    SeqLock() = default;
+    explicit SeqLock(const T &value);
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    void write(const T &value);
+
+    /// \return a consistent copy of the data, retrying as long as writes interfere
+    T read() const;
+
+    /// makes one attempt to copy the data.
+    /// \return false if a write interfered
+    bool tryRead(T &value) const;
+
+    /// \return number of writes so far
+    Ulong writes() const;
+
+  private:
+    static constexpr size_t words{(sizeof(T) + sizeof(Ulong) - 1) / sizeof(Ulong)};
+
+    bool copy(T &value) const;
+
+    std::atomic<Ulong> m_sequence{}; // odd while a write is in progress
+    std::array<std::atomic<Ulong>, words> m_data{};
+};
+
+template <typename T> SeqLock<T>::SeqLock(const T &value)
+{
+    write(value);
+}
+
+template <typename T> void SeqLock<T>::write(const T &value)
+{
+    std::array<Ulong, words> buffer{};
+    std::memcpy(buffer.data(), std::addressof(value), sizeof(T));
+
+    Kernel::CriticalSection cs;
+    const auto sequence{m_sequence.load(std::memory_order_relaxed)};
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t word{}; word < words; ++word)
+    {
+        m_data[word].store(buffer[word], std::memory_order_relaxed);
+    }
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename T> T SeqLock<T>::read() const
+{
+    T value;
+    while (not copy(value))
+    {
+    }
+
+    return value;
+}
+
+template <typename T> bool SeqLock<T>::tryRead(T &value) const
+{
+    return copy(value);
+}
+
+template <typename T> Ulong SeqLock<T>::writes() const
+{
+    return m_sequence.load(std::memory_order_relaxed) / 2;
+}
+
+template <typename T> bool SeqLock<T>::copy(T &value) const
+{
+    const auto sequence{m_sequence.load(std::memory_order_acquire)};
+    if (sequence & 1)
+    {
+        return false;
+    }
+
+    std::array<Ulong, words> buffer;
+    for (size_t word{}; word < words; ++word)
+    {
+        buffer[word] = m_data[word].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_sequence.load(std::memory_order_relaxed) != sequence)
+    {
+        return false;
+    }
+
+    std::memcpy(std::addressof(value), buffer.data(), sizeof(T));
+    return true;
+}
+} // namespace ThreadX
@@ -0,0 +1,214 @@
+#include "sharedMutex.hpp"
+#include "kernel.hpp"
+#include <cassert>
+#include <utility>
+
+namespace ThreadX
+{
+SharedMutex::SharedMutex(const SharedMutexPreference preference) : SharedMutex{"sharedMutex", preference}
+{
+}
+
+SharedMutex::SharedMutex(const std::string_view name, const SharedMutexPreference preference)
+    : m_preference{preference}, m_writerMutex{name, InheritMode::inherit}, m_readerGate{name}, m_writerGate{name}
+{
+}
+
+Error SharedMutex::lock()
+{
+    return try_lock_for(TickTimer::waitForever);
+}
+
+Error SharedMutex::try_lock()
+{
+    return try_lock_for(TickTimer::noWait);
+}
+
+Error SharedMutex::unlock()
+{
+    if (m_writerMutex.lockingThreadID() != uintptr_t(Native::tx_thread_identify()) or not(m_state.load() & writerActive))
+    {
+        return Error::notOwned;
+    }
+
+    releaseWriter();
+    return m_writerMutex.unlock();
+}
+
+Error SharedMutex::lock_shared()
+{
+    return try_lock_shared_for(TickTimer::waitForever);
+}
+
+Error SharedMutex::try_lock_shared()
+{
+    return try_lock_shared_for(TickTimer::noWait);
+}
+
+Error SharedMutex::unlock_shared()
+{
+    auto state{m_state.load()};
+    do
+    {
+        if ((state & readerMask) == 0)
+        {
+            return Error::notOwned;
+        }
+    } while (not m_state.compare_exchange_weak(state, state - 1));
+
+    // the last reader out lets in a writer waiting for it.
+    if ((state & readerMask) == 1 and (state & writerPending))
+    {
+        bool wake{};
+        {
+            Kernel::CriticalSection cs;
+            wake = std::exchange(m_writerWaiting, false);
+        }
+
+        if (wake)
+        {
+            [[maybe_unused]] auto error{m_writerGate.release()};
+            assert(error == Error::success);
+        }
+    }
+
+    return Error::success;
+}
+
+std::string_view SharedMutex::name() const
+{
+    return m_writerMutex.name();
+}
+
+Ulong SharedMutex::readers() const
+{
+    return m_state.load() & readerMask;
+}
+
+Error SharedMutex::get(const Ulong ticks)
+{
+    Timeout timeout{ticks};
+    if (Error error{m_writerMutex.try_lock_for(TickTimer::Duration{timeout.remaining()})}; error != Error::success)
+    {
+        return error;
+    }
+
+    m_state.fetch_or(writerPending);
+
+    while (true)
+    {
+        {
+            Kernel::CriticalSection cs;
+            if (auto state{m_state.load()}; (state & readerMask) == 0)
+            {
+                m_state.store(state | writerActive);
+                return Error::success;
+            }
+
+            m_writerWaiting = true;
+        }
+
+        if (Error error{m_writerGate.tryAcquireFor(TickTimer::Duration{timeout.remaining()})}; error != Error::success)
+        {
+            bool woken{};
+            {
+                Kernel::CriticalSection cs;
+                woken = not std::exchange(m_writerWaiting, false);
+            }
+
+            if (woken)
+            {
+                // the last reader cleared m_writerWaiting and is about to release the gate, so the readers are gone.
+                error = m_writerGate.acquire();
+                assert(error == Error::success);
+                continue;
+            }
+
+            releaseWriter();
+            [[maybe_unused]] auto unlockError{m_writerMutex.unlock()};
+            assert(unlockError == Error::success);
+            return error == Error::noInstance ? Error::notAvailable : error;
+        }
+    }
+}
+
+Error SharedMutex::getShared(const Ulong ticks)
+{
+    for (auto state{m_state.load()}; admitsReader(state);)
+    {
+        if (m_state.compare_exchange_weak(state, state + 1))
+        {
+            return Error::success;
+        }
+    }
+
+    if (ticks == TickTimer::noWait.count())
+    {
+        return Error::notAvailable;
+    }
+
+    if (not Native::tx_thread_identify())
+    {
+        return Error::callerError;
+    }
+
+    Timeout timeout{ticks};
+    while (true)
+    {
+        Ulong generation{};
+        {
+            Kernel::CriticalSection cs;
+            if (auto state{m_state.load()}; admitsReader(state))
+            {
+                m_state.store(state + 1);
+                return Error::success;
+            }
+
+            ++m_readersWaiting;
+            generation = m_readerGeneration;
+        }
+
+        if (Error error{m_readerGate.tryAcquireFor(TickTimer::Duration{timeout.remaining()})}; error != Error::success)
+        {
+            bool woken{};
+            {
+                Kernel::CriticalSection cs;
+                woken = generation != m_readerGeneration;
+                m_readersWaiting -= woken ? 0 : 1;
+            }
+
+            if (not woken)
+            {
+                return error == Error::noInstance ? Error::notAvailable : error;
+            }
+
+            // a token was counted for us, take it so that it does not wake a later reader for nothing.
+            error = m_readerGate.acquire();
+            assert(error == Error::success);
+        }
+    }
+}
+
+bool SharedMutex::admitsReader(const Ulong state) const
+{
+    const auto blocking{m_preference == SharedMutexPreference::writer ? writerActive | writerPending : writerActive};
+    return (state & blocking) == 0 and (state & readerMask) < readerMask;
+}
+
+void SharedMutex::releaseWriter()
+{
+    Ulong readersWaiting{};
+    {
+        Kernel::CriticalSection cs;
+        m_state.fetch_and(~(writerActive | writerPending));
+        readersWaiting = std::exchange(m_readersWaiting, 0);
+        m_readerGeneration += readersWaiting > 0 ? 1 : 0;
+    }
+
+    if (readersWaiting > 0)
+    {
+        [[maybe_unused]] auto error{m_readerGate.release(readersWaiting)};
+        assert(error == Error::success);
+    }
+}
+} // namespace ThreadX
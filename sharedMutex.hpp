@@ -0,0 +1,106 @@
+#pragma once
+
+#include "mutex.hpp"
+#include "semaphore.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <atomic>
+#include <limits>
+#include <shared_mutex>
+#include <string_view>
+
+#define tryLockShared() try_lock_shared()
+#define tryLockSharedUntil(x) try_lock_shared_until(x)
+#define tryLockSharedFor(x) try_lock_shared_for(x)
+
+namespace ThreadX
+{
+/// Who goes first when readers and a writer compete for a SharedMutex.
+enum class SharedMutexPreference
+{
+    reader, ///< readers keep entering while a writer waits for the current readers to leave. Writers may starve.
+    writer  ///< a waiting writer stops new readers from entering.
+};
+
+/// Reader-writer mutex. Readers take and give shared ownership with an atomic compare-exchange, without kernel calls,
+/// as long as no writer holds or (with SharedMutexPreference::writer) waits for the mutex. Writers are serialised by a
+/// Mutex with priority inheritance. Ownership is not recursive. Same interface as std::shared_timed_mutex, so it works
+/// with std::lock_guard, std::unique_lock and std::shared_lock.
+class SharedMutex
+{
+  public:
+    explicit SharedMutex(const SharedMutexPreference preference = SharedMutexPreference::writer);
+    explicit SharedMutex(const std::string_view name, const SharedMutexPreference preference = SharedMutexPreference::writer);
+
+    SharedMutex(const SharedMutex &) = delete;
+    SharedMutex &operator=(const SharedMutex &) = delete;
+
+    /// obtains exclusive ownership, once all readers have left.
+    Error lock();
+
+    Error try_lock();
+
+    template <class Clock, typename Duration> auto try_lock_until(const std::chrono::time_point<Clock, Duration> &time);
+
+    template <typename Rep, typename Period> auto try_lock_for(const std::chrono::duration<Rep, Period> &duration);
+
+    Error unlock();
+
+    /// obtains shared ownership, along with any other readers.
+    Error lock_shared();
+
+    Error try_lock_shared();
+
+    template <class Clock, typename Duration> auto try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &time);
+
+    template <typename Rep, typename Period> auto try_lock_shared_for(const std::chrono::duration<Rep, Period> &duration);
+
+    Error unlock_shared();
+
+    std::string_view name() const;
+
+    /// \return number of threads holding shared ownership
+    Ulong readers() const;
+
+  private:
+    static constexpr Ulong writerActive{Ulong{1} << (std::numeric_limits<Ulong>::digits - 1)};
+    static constexpr Ulong writerPending{writerActive >> 1};
+    static constexpr Ulong readerMask{writerPending - 1};
+
+    Error get(const Ulong ticks);
+    Error getShared(const Ulong ticks);
+    bool admitsReader(const Ulong state) const;
+    void releaseWriter();
+
+    const SharedMutexPreference m_preference;
+    std::atomic<Ulong> m_state{}; // reader count | writerPending | writerActive
+    Mutex m_writerMutex;
+    CountingSemaphore<> m_readerGate;
+    Ulong m_readersWaiting{};
+    Ulong m_readerGeneration{}; // counts the wakeups of m_readerGate, so that a reader that timed out knows whether a token was given to it.
+    BinarySemaphore m_writerGate;
+    bool m_writerWaiting{};
+};
+
+template <class Clock, typename Duration> auto SharedMutex::try_lock_until(const std::chrono::time_point<Clock, Duration> &time)
+{
+    return try_lock_for(time - Clock::now());
+}
+
+template <typename Rep, typename Period> auto SharedMutex::try_lock_for(const std::chrono::duration<Rep, Period> &duration)
+{
+    return get(TickTimer::ticks(duration));
+}
+
+template <class Clock, typename Duration> auto SharedMutex::try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &time)
+{
+    return try_lock_shared_for(time - Clock::now());
+}
+
+template <typename Rep, typename Period> auto SharedMutex::try_lock_shared_for(const std::chrono::duration<Rep, Period> &duration)
+{
+    return getShared(TickTimer::ticks(duration));
+}
+
+using SharedLock = std::shared_lock<SharedMutex>;
+} // namespace ThreadX
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "kernel.hpp"
+#include "memoryPool.hpp"
+#include "mutex.hpp"
+#include "txCommon.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace ThreadX
+{
+/// Version of the data held by a Snapshot, one per pool block.
+template <typename T> struct SnapshotNode
+{
+    T value;
+    SnapshotNode *next;
+    Ulong retiredEpoch;
+};
+
+/// Minimum block size of the pool of a Snapshot<T>.
+template <typename T> inline constexpr size_t snapshotBlockSize{sizeof(SnapshotNode<T>)};
+
+/// Holder of the latest published version of T, in the style of read-copy-update. Writers publish a new version
+/// allocated from a BlockPool. Readers get wait-free references to the current version, which stays valid until the
+/// reference is dropped, however many versions are published meanwhile. Old versions are reclaimed by the writers once
+/// every reader has left the epoch in which they were replaced.
+/// Readers register once per thread with a Reader object, which holds the reader's epoch slot.
+/// \tparam T data type, the pool's block size must be at least snapshotBlockSize<T>
+/// \tparam Pool BlockPool
+/// \tparam MaxReaders number of Reader objects that can exist at the same time
+template <typename T, class Pool, size_t MaxReaders = 8> class Snapshot
+{
+    static_assert(std::is_base_of_v<BlockPoolBase, Pool>);
+
+    using Node = SnapshotNode<T>;
+
+  public:
+    /// Reference to a version, valid as long as the object lives.
+    class ReadReference
+    {
+      public:
+        ReadReference(const ReadReference &) = delete;
+        ReadReference &operator=(const ReadReference &) = delete;
+        ~ReadReference();
+
+        const T &operator*() const;
+        const T *operator->() const;
+
+      private:
+        friend class Snapshot;
+
+        ReadReference(std::atomic<Ulong> &epoch, const T &value);
+
+        std::atomic<Ulong> &m_epoch;
+        const T &m_value;
+    };
+
+    /// Registration of a reading thread. A reader has at most one ReadReference at a time.
+    class Reader
+    {
+      public:
+        explicit Reader(Snapshot &snapshot);
+        ~Reader();
+
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        /// \return reference to the current version
+        [[nodiscard]] ReadReference read();
+
+      private:
+        Snapshot &m_snapshot;
+        size_t m_slot;
+    };
+
+    /// \param initial value of the first version, allocated from pool
+    explicit Snapshot(Pool &pool, const T &initial = T{});
+    ~Snapshot();
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    /// Publishes a new version. Versions that no reader can still see are reclaimed first.
+    /// \param duration time to wait for a free block
+    template <typename Rep = TickTimer::rep, typename Period = TickTimer::period> Error publish(const T &value, const std::chrono::duration<Rep, Period> &duration = TickTimer::noWait);
+
+    /// Returns the versions that no reader can still see to the pool.
+    /// \return number of versions that are still retired
+    size_t reclaim();
+
+  private:
+    static constexpr Ulong quiescent{};
+
+    Node *allocate(const T &value, const Ulong ticks);
+    void free(Node *const nodePtr);
+    size_t reclaimRetired();
+
+    Pool &m_pool;
+    std::atomic<Node *> m_current{};
+    std::atomic<Ulong> m_epoch{1};
+    std::array<std::atomic<Ulong>, MaxReaders> m_readerEpochs{}; // epoch a reader entered in, quiescent when it is not reading
+    std::array<bool, MaxReaders> m_slotUsed{};
+    Node *m_retired{};
+    Mutex m_writerMutex;
+};
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::ReadReference::ReadReference(std::atomic<Ulong> &epoch, const T &value) : m_epoch{epoch}, m_value{value}
+{
+}
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::ReadReference::~ReadReference()
+{
+    m_epoch.store(quiescent, std::memory_order_release);
+}
+
+template <typename T, class Pool, size_t MaxReaders> const T &Snapshot<T, Pool, MaxReaders>::ReadReference::operator*() const
+{
+    return m_value;
+}
+
+template <typename T, class Pool, size_t MaxReaders> const T *Snapshot<T, Pool, MaxReaders>::ReadReference::operator->() const
+{
+    return std::addressof(m_value);
+}
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::Reader::Reader(Snapshot &snapshot) : m_snapshot{snapshot}, m_slot{MaxReaders}
+{
+    Kernel::CriticalSection cs;
+    for (size_t slot{}; slot < MaxReaders; ++slot)
+    {
+        if (not snapshot.m_slotUsed[slot])
+        {
+            snapshot.m_slotUsed[slot] = true;
+            m_slot = slot;
+            break;
+        }
+    }
+
+    assert(m_slot < MaxReaders);
+}
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::Reader::~Reader()
+{
+    Kernel::CriticalSection cs;
+    m_snapshot.m_slotUsed[m_slot] = false;
+}
+
+template <typename T, class Pool, size_t MaxReaders> auto Snapshot<T, Pool, MaxReaders>::Reader::read() -> ReadReference
+{
+    auto &epoch{m_snapshot.m_readerEpochs[m_slot]};
+    assert(epoch.load(std::memory_order_relaxed) == quiescent);
+
+    // the epoch must be visible to writers before the current version is loaded, see reclaimRetired().
+    epoch.store(m_snapshot.m_epoch.load());
+    return ReadReference{epoch, m_snapshot.m_current.load()->value};
+}
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::Snapshot(Pool &pool, const T &initial) : m_pool{pool}, m_writerMutex{"snapshot"}
+{
+    assert(pool.blockSize() >= snapshotBlockSize<T>);
+
+    m_current = allocate(initial, TickTimer::noWait.count());
+    assert(m_current.load());
+}
+
+template <typename T, class Pool, size_t MaxReaders> Snapshot<T, Pool, MaxReaders>::~Snapshot()
+{
+    free(m_current.load());
+    while (m_retired)
+    {
+        free(std::exchange(m_retired, m_retired->next));
+    }
+}
+
+template <typename T, class Pool, size_t MaxReaders> template <typename Rep, typename Period> Error Snapshot<T, Pool, MaxReaders>::publish(const T &value, const std::chrono::duration<Rep, Period> &duration)
+{
+    LockGuard lock{m_writerMutex};
+    reclaimRetired();
+
+    auto nodePtr{allocate(value, TickTimer::ticks(duration))};
+    if (not nodePtr)
+    {
+        return Error::noMemory;
+    }
+
+    // readers entering from the next epoch on cannot see the old version.
+    auto oldPtr{m_current.exchange(nodePtr)};
+    auto epoch{m_epoch.load()};
+    oldPtr->retiredEpoch = epoch;
+    oldPtr->next = m_retired;
+    m_retired = oldPtr;
+    m_epoch.store(++epoch == quiescent ? ++epoch : epoch);
+
+    return Error::success;
+}
+
+template <typename T, class Pool, size_t MaxReaders> size_t Snapshot<T, Pool, MaxReaders>::reclaim()
+{
+    LockGuard lock{m_writerMutex};
+    return reclaimRetired();
+}
+
+template <typename T, class Pool, size_t MaxReaders> auto Snapshot<T, Pool, MaxReaders>::allocate(const T &value, const Ulong ticks) -> Node *
+{
+    auto [error, memoryPtr]{m_pool.allocate(TickTimer::Duration{ticks})};
+    if (error != Error::success)
+    {
+        return nullptr;
+    }
+
+    return new (memoryPtr) Node{value, nullptr, quiescent};
+}
+
+template <typename T, class Pool, size_t MaxReaders> void Snapshot<T, Pool, MaxReaders>::free(Node *const nodePtr)
+{
+    nodePtr->~Node();
+    [[maybe_unused]] Error error{Pool::release(reinterpret_cast<std::byte *>(nodePtr))};
+    assert(error == Error::success);
+}
+
+template <typename T, class Pool, size_t MaxReaders> size_t Snapshot<T, Pool, MaxReaders>::reclaimRetired()
+{
+    // a reader that entered in the epoch a version was retired, or before, may still hold it. Epochs wrap around.
+    auto visible = [this](const Node &node) {
+        for (const auto &readerEpoch : m_readerEpochs)
+        {
+            if (const auto epoch{readerEpoch.load()}; epoch != quiescent and Long(epoch - node.retiredEpoch) <= 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    size_t retired{};
+    for (auto nodePtrPtr{std::addressof(m_retired)}; *nodePtrPtr;)
+    {
+        if (auto nodePtr{*nodePtrPtr}; not visible(*nodePtr))
+        {
+            *nodePtrPtr = nodePtr->next;
+            free(nodePtr);
+        }
+        else
+        {
+            nodePtrPtr = std::addressof(nodePtr->next);
+            ++retired;
+        }
+    }
+
+    return retired;
+}
+} // namespace ThreadX
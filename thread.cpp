@@ -13,3 +13,49 @@ void yield()
     Native::tx_thread_relinquish();
 }
 } // namespace ThreadX::ThisThread
+
+namespace ThreadX
+{
+ThreadBase::ThreadBase() : Native::TX_THREAD{}
+{
+}
+
+ThreadBase *ThreadBase::current()
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    if (not threadPtr or threadPtr->tx_thread_entry != entryFunction or Kernel::inIsr())
+    {
+        return nullptr;
+    }
+
+    return static_cast<ThreadBase *>(threadPtr);
+}
+
+void ThreadBase::entryFunction(Ulong thisPtr)
+{
+    reinterpret_cast<ThreadBase *>(thisPtr)->entryCallback();
+}
+
+void ThreadBase::destroyLocals()
+{
+    for (size_t index{}; index < m_localKeyCount; ++index)
+    {
+        if (const auto bit{Ulong{1} << index}; m_localsConstructed & bit)
+        {
+            m_localKeys[index].destructor(m_localStorage.data() + m_localKeys[index].offset);
+            m_localsConstructed &= ~bit;
+        }
+    }
+}
+
+size_t ThreadBase::registerLocal(const size_t size, const size_t alignment, const Destructor destructor)
+{
+    Kernel::CriticalSection cs;
+    const auto offset{(m_localStorageUsed + alignment - 1) / alignment * alignment};
+    assert(m_localKeyCount < maxThreadLocals and offset + size <= threadLocalSize); // raise THREADX_THREAD_LOCAL_SIZE
+
+    m_localStorageUsed = offset + size;
+    m_localKeys[m_localKeyCount] = {offset, destructor};
+    return m_localKeyCount++;
+}
+} // namespace ThreadX
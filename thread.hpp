@@ -5,7 +5,15 @@
 #include "semaphore.hpp"
 #include "tickTimer.hpp"
 #include "txCommon.hpp"
+#include <array>
 #include <cassert>
+#include <climits>
+#include <cstddef>
+#include <new>
+
+#ifndef THREADX_THREAD_LOCAL_SIZE
+#define THREADX_THREAD_LOCAL_SIZE 64
+#endif
 
 namespace ThreadX::ThisThread
 {
@@ -66,8 +74,70 @@ enum class ThreadNotifyCondition : Uint
 inline constexpr Uint defaultPriority{16}; ///
 inline constexpr Ulong noTimeSlice{};
 inline constexpr Ulong minimumStackSize{TX_MINIMUM_STACK};
+inline constexpr size_t threadLocalSize{THREADX_THREAD_LOCAL_SIZE}; ///< bytes of ThreadLocal storage in every Thread
+inline constexpr size_t maxThreadLocals{wordSize * CHAR_BIT};
+
+template <typename T> class ThreadLocal;
+
+/// Part of Thread that does not depend on the pool. It holds the storage of the ThreadLocal objects inline, and its entry
+/// function tells wrapper threads apart from threads created by other code.
+class ThreadBase : protected Native::TX_THREAD
+{
+  public:
+    ThreadBase(const ThreadBase &) = delete;
+    ThreadBase &operator=(const ThreadBase &) = delete;
+
+    /// \return the calling thread, nullptr if it is not a Thread or if called from an ISR
+    static ThreadBase *current();
+
+  protected:
+    ThreadBase();
+    ~ThreadBase() = default;
+
+    static void entryFunction(Ulong thisPtr);
+
+    /// runs the destructors of the thread's ThreadLocal objects, from the exit notification.
+    void destroyLocals();
+
+  private:
+    template <typename T> friend class ThreadLocal;
+
+    using Destructor = void (*)(std::byte *const objectPtr);
+    using LocalKey = struct
+    {
+        size_t offset;
+        Destructor destructor;
+    };
+
+    /// reserves storage for a ThreadLocal object in every thread.
+    /// \return key index
+    static size_t registerLocal(const size_t size, const size_t alignment, const Destructor destructor);
+
+    template <typename T> T *local(const size_t index);
 
-template <class Pool> class Thread : Native::TX_THREAD
+    virtual void entryCallback() = 0;
+
+    static inline std::array<LocalKey, maxThreadLocals> m_localKeys{};
+    static inline size_t m_localKeyCount{};
+    static inline size_t m_localStorageUsed{};
+
+    Ulong m_localsConstructed{}; // one bit per key index
+    alignas(std::max_align_t) std::array<std::byte, threadLocalSize> m_localStorage{};
+};
+
+template <typename T> T *ThreadBase::local(const size_t index)
+{
+    auto storagePtr{m_localStorage.data() + m_localKeys[index].offset};
+    if (const auto bit{Ulong{1} << index}; not(m_localsConstructed & bit))
+    {
+        new (storagePtr) T{};
+        m_localsConstructed |= bit;
+    }
+
+    return std::launder(reinterpret_cast<T *>(storagePtr));
+}
+
+template <class Pool> class Thread : public ThreadBase
 {
   public:
     using ErrorCallback = std::function<void(Thread &)>;
@@ -163,14 +233,11 @@ template <class Pool> class Thread : Native::TX_THREAD
     ~Thread();
 
   private:
-    static auto entryFunction(Ulong thisPtr);
     static auto stackErrorNotifyCallback(Native::TX_THREAD *const threadPtr);
     static auto entryExitNotifyCallback(auto *const threadPtr, const auto condition);
 
     auto init(const std::string_view name, const ThreadX::Ulong stackSize, const Uint priority, const Uint preamptionThresh, const Ulong timeSlice, const ThreadStartType startType);
 
-    virtual void entryCallback() = 0;
-
     static inline ErrorCallback m_stackErrorNotifyCallback;
 
     Allocation<Pool> m_stackAlloc;
@@ -197,7 +264,7 @@ template <class Pool> auto Thread<Pool>::registerStackErrorNotifyCallback(const
 template <class Pool>
 Thread<Pool>::Thread(const std::string_view name, Pool &pool, const Ulong stackSize, const NotifyCallback &entryExitNotifyCallback, const Uint priority, const Uint preamptionThresh, const Ulong timeSlice, const ThreadStartType startType)
     requires(std::is_base_of_v<BytePoolBase, Pool>)
-    : Native::TX_THREAD{}, m_stackAlloc{pool, stackSize}, m_entryExitNotifyCallback{entryExitNotifyCallback}
+    : m_stackAlloc{pool, stackSize}, m_entryExitNotifyCallback{entryExitNotifyCallback}
 {
     init(name, stackSize, priority, preamptionThresh, timeSlice, startType);
 }
@@ -205,7 +272,7 @@ Thread<Pool>::Thread(const std::string_view name, Pool &pool, const Ulong stackS
 template <class Pool>
 Thread<Pool>::Thread(const std::string_view name, Pool &pool, const NotifyCallback &entryExitNotifyCallback, const Uint priority, const Uint preamptionThresh, const Ulong timeSlice, const ThreadStartType startType)
     requires(std::is_base_of_v<BlockPoolBase, Pool>)
-    : Native::TX_THREAD{}, m_stackAlloc{pool}, m_entryExitNotifyCallback{entryExitNotifyCallback}
+    : m_stackAlloc{pool}, m_entryExitNotifyCallback{entryExitNotifyCallback}
 {
     init(name, pool.blockSize(), priority, preamptionThresh, timeSlice, startType);
 }
@@ -213,7 +280,7 @@ Thread<Pool>::Thread(const std::string_view name, Pool &pool, const NotifyCallba
 template <class Pool> auto Thread<Pool>::init(const std::string_view name, const ThreadX::Ulong stackSize, const Uint priority, const Uint preamptionThresh, const Ulong timeSlice, const ThreadStartType startType)
 {
     using namespace Native;
-    [[maybe_unused]] Error error{tx_thread_create(this, const_cast<char *>(name.data()), entryFunction, reinterpret_cast<Ulong>(this), m_stackAlloc.get(), stackSize, priority, preamptionThresh, timeSlice, std::to_underlying(startType))};
+    [[maybe_unused]] Error error{tx_thread_create(this, const_cast<char *>(name.data()), entryFunction, reinterpret_cast<Ulong>(static_cast<ThreadBase *>(this)), m_stackAlloc.get(), stackSize, priority, preamptionThresh, timeSlice, std::to_underlying(startType))};
     assert(error == Error::success);
 
     error = Error{tx_thread_entry_exit_notify(this, Thread::entryExitNotifyCallback)};
@@ -349,11 +416,6 @@ template <class Pool> auto Thread<Pool>::stackInfo() const
                      .maxUsedPercent = (uintptr_t(tx_thread_stack_end) - uintptr_t(tx_thread_stack_highest_ptr) + 1) * 100 / tx_thread_stack_size}; // As a rule of thumb, keep this below 70%
 }
 
-template <class Pool> auto Thread<Pool>::entryFunction(Ulong thisPtr)
-{
-    reinterpret_cast<Thread *>(thisPtr)->entryCallback();
-}
-
 template <class Pool> auto Thread<Pool>::stackErrorNotifyCallback(Native::TX_THREAD *const threadPtr)
 {
     auto &thread{static_cast<Thread &>(*threadPtr)};
@@ -372,6 +434,8 @@ template <class Pool> auto Thread<Pool>::entryExitNotifyCallback(auto *const thr
 
     if (notifyCondition == ThreadNotifyCondition::exit)
     {
+        thread.destroyLocals();
+
         if (thread.m_exitSignalPtr)
         {
             [[maybe_unused]] auto error{thread.m_exitSignalPtr->release()};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "thread.hpp"
+#include <memory>
+
+namespace ThreadX
+{
+/// Storage slot with a separate instance of T in every Thread, such as a per-thread cache or log buffer.
+/// The instances live inline in the Thread objects, threadLocalSize bytes per thread shared by all ThreadLocal objects.
+/// An instance is value-initialised on first access by its thread, and destroyed when the thread exits or is terminated.
+/// Keys are never given back, so ThreadLocal objects are meant to have static storage duration.
+template <typename T> class ThreadLocal
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+
+  public:
+    ThreadLocal();
+
+    ThreadLocal(const ThreadLocal &) = delete;
+    ThreadLocal &operator=(const ThreadLocal &) = delete;
+
+    /// \return the calling thread's instance, nullptr if not called from a Thread
+    T *get();
+
+    T &operator*();
+
+    T *operator->();
+
+  private:
+    static void destroy(std::byte *const objectPtr);
+
+    const size_t m_index;
+};
+
+template <typename T> ThreadLocal<T>::ThreadLocal() : m_index{ThreadBase::registerLocal(sizeof(T), alignof(T), destroy)}
+{
+}
+
+template <typename T> T *ThreadLocal<T>::get()
+{
+    auto threadPtr{ThreadBase::current()};
+    return threadPtr ? threadPtr->local<T>(m_index) : nullptr;
+}
+
+template <typename T> T &ThreadLocal<T>::operator*()
+{
+    auto objectPtr{get()};
+    assert(objectPtr);
+    return *objectPtr;
+}
+
+template <typename T> T *ThreadLocal<T>::operator->()
+{
+    auto objectPtr{get()};
+    assert(objectPtr);
+    return objectPtr;
+}
+
+template <typename T> void ThreadLocal<T>::destroy(std::byte *const objectPtr)
+{
+    std::destroy_at(std::launder(reinterpret_cast<T *>(objectPtr)));
+}
+} // namespace ThreadX
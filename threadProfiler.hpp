@@ -0,0 +1,188 @@
+#pragma once
+
+#include "highResClock.hpp"
+#include "kernel.hpp"
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <functional>
+#include <limits>
+#include <string_view>
+
+namespace ThreadX
+{
+/// Records activation period, execution time and blocking time of the threads that call it, as input for the
+/// rate-monotonic analysis in rateMonotonic.hpp. report() writes the records as CSV, which tools/rmaReport reads on the host.
+/// Threads mark their activations explicitly, typically at the top and bottom of their job loop.
+/// \tparam Clock time base for the measurements. Ticks are usually too coarse for execution times.
+/// \tparam MaxThreads number of threads that can be profiled
+template <class Clock = HighResClock, size_t MaxThreads = 16> class ThreadProfiler
+{
+  public:
+    using SinkCallback = std::function<void(const std::string_view)>;
+    using Record = struct
+    {
+        Native::TX_THREAD *threadPtr;
+        Ulong activations;
+        Ulong64 minPeriod;    ///< shortest time between two activations
+        Ulong64 maxExecution; ///< longest activation, less the time marked as blocked
+        Ulong64 maxBlocking;  ///< longest time marked as blocked in one activation
+        typename Clock::time_point lastActivation;
+        typename Clock::time_point blockingStart;
+        Ulong64 blocking;
+    };
+
+    ThreadProfiler() = default;
+    ThreadProfiler(const ThreadProfiler &) = delete;
+    ThreadProfiler &operator=(const ThreadProfiler &) = delete;
+
+    /// Marks the start of an activation of the calling thread.
+    void activationBegin();
+
+    /// Marks the end of the current activation of the calling thread.
+    void activationEnd();
+
+    /// Marks the start of a wait on a resource shared with lower priority threads, such as a Mutex.
+    void blockingBegin();
+
+    void blockingEnd();
+
+    void clear();
+
+    /// Writes one CSV line per profiled thread, after a header line.
+    /// \param sink called for every line, without the line terminator
+    void report(const SinkCallback &sink) const;
+
+  private:
+    Record *record();
+
+    std::array<Record, MaxThreads> m_records{};
+};
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::activationBegin()
+{
+    if (auto recordPtr{record()}; recordPtr)
+    {
+        const auto now{Clock::now()};
+        if (recordPtr->activations > 0)
+        {
+            recordPtr->minPeriod = std::min(recordPtr->minPeriod, Ulong64((now - recordPtr->lastActivation).count()));
+        }
+
+        ++recordPtr->activations;
+        recordPtr->lastActivation = now;
+        recordPtr->blocking = 0;
+    }
+}
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::activationEnd()
+{
+    if (auto recordPtr{record()}; recordPtr and recordPtr->activations > 0)
+    {
+        const Ulong64 elapsed((Clock::now() - recordPtr->lastActivation).count());
+        recordPtr->maxExecution = std::max(recordPtr->maxExecution, elapsed - std::min(elapsed, recordPtr->blocking));
+        recordPtr->maxBlocking = std::max(recordPtr->maxBlocking, recordPtr->blocking);
+    }
+}
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::blockingBegin()
+{
+    if (auto recordPtr{record()}; recordPtr)
+    {
+        recordPtr->blockingStart = Clock::now();
+    }
+}
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::blockingEnd()
+{
+    if (auto recordPtr{record()}; recordPtr)
+    {
+        recordPtr->blocking += Ulong64((Clock::now() - recordPtr->blockingStart).count());
+    }
+}
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::clear()
+{
+    Kernel::CriticalSection cs;
+    m_records = {};
+}
+
+template <class Clock, size_t MaxThreads> void ThreadProfiler<Clock, MaxThreads>::report(const SinkCallback &sink) const
+{
+    using Period = typename Clock::period;
+    std::array<char, 160> line;
+
+    auto append = [&line](char *pos, const auto value) { return std::to_chars(pos, line.data() + line.size(), value).ptr; };
+    auto appendText = [&line](char *pos, const std::string_view text) {
+        const auto size{std::min(text.size(), size_t(line.data() + line.size() - pos))};
+        return std::copy_n(text.data(), size, pos);
+    };
+
+    auto pos{appendText(line.data(), "# time units per second: ")};
+    pos = append(pos, Ulong64(Period::den / Period::num));
+    sink({line.data(), pos});
+    sink("name,priority,preemption,period,wcet,blocking,activations,preemptions");
+
+    for (const auto &record : m_records)
+    {
+        if (not record.threadPtr or record.activations < 2)
+        {
+            continue;
+        }
+
+        Ulong preemptions{};
+#ifdef TX_THREAD_ENABLE_PERFORMANCE_INFO
+        Ulong solicitedPreemptions{};
+        Ulong interruptPreemptions{};
+        if (Error{Native::tx_thread_performance_info_get(record.threadPtr, nullptr, nullptr, std::addressof(solicitedPreemptions), std::addressof(interruptPreemptions), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)} ==
+            Error::success)
+        {
+            preemptions = solicitedPreemptions + interruptPreemptions;
+        }
+#endif
+
+        pos = appendText(line.data(), record.threadPtr->tx_thread_name);
+        for (const auto value : {Ulong64{record.threadPtr->tx_thread_user_priority}, Ulong64{record.threadPtr->tx_thread_user_preempt_threshold}, record.minPeriod, record.maxExecution, record.maxBlocking,
+                                 Ulong64{record.activations}, Ulong64{preemptions}})
+        {
+            pos = appendText(pos, ",");
+            pos = append(pos, value);
+        }
+
+        sink({line.data(), pos});
+    }
+}
+
+template <class Clock, size_t MaxThreads> auto ThreadProfiler<Clock, MaxThreads>::record() -> Record *
+{
+    auto threadPtr{Native::tx_thread_identify()};
+    if (not threadPtr)
+    {
+        return nullptr;
+    }
+
+    // only the owning thread writes a record once it is claimed, so claiming is the only step that needs locking.
+    for (auto &record : m_records)
+    {
+        if (record.threadPtr == threadPtr)
+        {
+            return std::addressof(record);
+        }
+    }
+
+    Kernel::CriticalSection cs;
+    for (auto &record : m_records)
+    {
+        if (not record.threadPtr)
+        {
+            record.threadPtr = threadPtr;
+            record.minPeriod = std::numeric_limits<Ulong64>::max();
+            return std::addressof(record);
+        }
+    }
+
+    return nullptr;
+}
+} // namespace ThreadX
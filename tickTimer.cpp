@@ -45,4 +45,19 @@ void TickTimer::expirationCallback(const Ulong timerPtr)
     auto &timer{*reinterpret_cast<TickTimer *>(timerPtr)};
     timer.m_expirationCallback(timer.m_id);
 }
+
+Timeout::Timeout(const Ulong ticks) : m_ticks{ticks}, m_start{Native::tx_time_get()}
+{
+}
+
+Ulong Timeout::remaining() const
+{
+    if (m_ticks == TickTimer::noWait.count() or m_ticks == TickTimer::waitForever.count())
+    {
+        return m_ticks;
+    }
+
+    const Ulong elapsed{Native::tx_time_get() - m_start};
+    return elapsed < m_ticks ? m_ticks - elapsed : 0;
+}
 } // namespace ThreadX
@@ -91,6 +91,21 @@ class TickTimer : Native::TX_TIMER
 
 static_assert(std::chrono::is_clock_v<TickTimer>);
 
+/// Keeps track of what is left of a timeout that is spread over several waits.
+/// TickTimer::noWait and TickTimer::waitForever stay as they are.
+class Timeout
+{
+  public:
+    explicit Timeout(const Ulong ticks);
+
+    /// \return ticks left to wait
+    Ulong remaining() const;
+
+  private:
+    const Ulong m_ticks;
+    const Ulong m_start;
+};
+
 /// Returns the internal tick count ceiled to tick duration (usually 10ms).
 ///\tparam Rep
 ///\tparam Period
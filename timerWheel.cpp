@@ -0,0 +1,205 @@
+#include "timerWheel.hpp"
+#include "kernel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace ThreadX
+{
+SoftTimer::SoftTimer(const Callback &callback) : m_callback{callback}
+{
+}
+
+SoftTimer::~SoftTimer()
+{
+    if (m_wheelPtr)
+    {
+        m_wheelPtr->cancel(*this);
+    }
+}
+
+bool SoftTimer::active() const
+{
+    Kernel::CriticalSection cs;
+    return m_prevNextPtr;
+}
+
+TimerWheel::TimerWheel(WorkQueueBase &workQueue, const std::string_view name)
+    : m_workQueue{workQueue}, m_dispatchItem{[this](WorkItem &) { dispatch(); }}, m_tickTimer{name, TickTimer::Duration{1}, [this](auto) { advance(); }}
+{
+}
+
+void TimerWheel::start(SoftTimer &timer, const Ulong ticks)
+{
+    Kernel::CriticalSection cs;
+    if (timer.m_prevNextPtr)
+    {
+        remove(timer);
+        --m_active;
+    }
+
+    // a timer started during tick n expires at the earliest on tick n + 1, like a TX_TIMER.
+    timer.m_wheelPtr = this;
+    timer.m_expiry = m_now + std::max(ticks, 1UL);
+    insert(timer);
+    ++m_active;
+}
+
+bool TimerWheel::cancel(SoftTimer &timer)
+{
+    Kernel::CriticalSection cs;
+    if (not timer.m_prevNextPtr)
+    {
+        return false;
+    }
+
+    remove(timer);
+    --m_active;
+    return true;
+}
+
+Ulong TimerWheel::active() const
+{
+    return m_active;
+}
+
+void TimerWheel::insert(SoftTimer &timer)
+{
+    // timers beyond the range of the wheel go to the last slot of the top level, and are placed again when it comes up.
+    const auto delta{std::min(timer.m_expiry - m_now, range - 1)};
+    const auto target{m_now + delta};
+
+    Uint level{};
+    while (level < levels - 1 and delta >= (Ulong{1} << (slotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    link(m_wheel[level][(target >> (slotBits * level)) & (wheelSlots - 1)], timer);
+}
+
+void TimerWheel::advance()
+{
+    {
+        Kernel::CriticalSection cs;
+        ++m_now;
+    }
+
+    // when a level wraps around, the current slot of the level above is spread over the levels below.
+    for (Uint level{1}; level < levels and (m_now & ((Ulong{1} << (slotBits * level)) - 1)) == 0; ++level)
+    {
+        cascade(level);
+    }
+
+    // timers are moved one at a time, so that interrupts are not held off for a whole slot. Timers started meanwhile go
+    // to later slots, as they expire one tick from now at the earliest.
+    bool expired{};
+    auto &slot{m_wheel[0][m_now & (wheelSlots - 1)]};
+    while (true)
+    {
+        Kernel::CriticalSection cs;
+        if (not slot)
+        {
+            break;
+        }
+
+        auto &timer{*slot};
+        unlink(timer);
+        if (timer.m_expiry == m_now)
+        {
+            expire(timer);
+            expired = true;
+        }
+        else
+        {
+            insert(timer);
+        }
+    }
+
+    if (expired)
+    {
+        m_workQueue.post(m_dispatchItem);
+    }
+}
+
+void TimerWheel::cascade(const Uint level)
+{
+    auto &slot{m_wheel[level][(m_now >> (slotBits * level)) & (wheelSlots - 1)]};
+    while (true)
+    {
+        Kernel::CriticalSection cs;
+        if (not slot)
+        {
+            return;
+        }
+
+        auto &timer{*slot};
+        unlink(timer);
+        insert(timer);
+    }
+}
+
+void TimerWheel::dispatch()
+{
+    while (true)
+    {
+        SoftTimer *timerPtr{};
+        {
+            Kernel::CriticalSection cs;
+            if (timerPtr = m_expired; not timerPtr)
+            {
+                return;
+            }
+
+            remove(*timerPtr);
+            --m_active;
+        }
+
+        // the timer is inactive from here on, so the callback may start it again.
+        timerPtr->m_callback(*timerPtr);
+    }
+}
+
+void TimerWheel::expire(SoftTimer &timer)
+{
+    // appended, so that callbacks run in expiry order.
+    timer.m_next = nullptr;
+    timer.m_prevNextPtr = m_expiredTailPtr;
+    *m_expiredTailPtr = std::addressof(timer);
+    m_expiredTailPtr = std::addressof(timer.m_next);
+}
+
+void TimerWheel::remove(SoftTimer &timer)
+{
+    if (m_expiredTailPtr == std::addressof(timer.m_next))
+    {
+        m_expiredTailPtr = timer.m_prevNextPtr;
+    }
+
+    unlink(timer);
+}
+
+void TimerWheel::link(SoftTimer *&headPtr, SoftTimer &timer)
+{
+    timer.m_next = headPtr;
+    if (headPtr)
+    {
+        headPtr->m_prevNextPtr = std::addressof(timer.m_next);
+    }
+
+    timer.m_prevNextPtr = std::addressof(headPtr);
+    headPtr = std::addressof(timer);
+}
+
+void TimerWheel::unlink(SoftTimer &timer)
+{
+    *timer.m_prevNextPtr = timer.m_next;
+    if (timer.m_next)
+    {
+        timer.m_next->m_prevNextPtr = timer.m_prevNextPtr;
+    }
+
+    timer.m_next = nullptr;
+    timer.m_prevNextPtr = nullptr;
+}
+} // namespace ThreadX
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "tickTimer.hpp"
+#include "txCommon.hpp"
+#include "workQueue.hpp"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace ThreadX
+{
+class TimerWheel;
+
+/// One-shot timer of a TimerWheel, embedded in the object it times. It costs no kernel object, and starting or
+/// cancelling it takes constant time.
+class SoftTimer
+{
+  public:
+    using Callback = std::function<void(SoftTimer &)>;
+
+    explicit SoftTimer(const Callback &callback);
+
+    /// cancels the timer.
+    ~SoftTimer();
+
+    SoftTimer(const SoftTimer &) = delete;
+    SoftTimer &operator=(const SoftTimer &) = delete;
+
+    /// \return true if the timer is started and its callback has not been called
+    bool active() const;
+
+  private:
+    friend class TimerWheel;
+
+    const Callback m_callback;
+    TimerWheel *m_wheelPtr{};
+    SoftTimer *m_next{};
+    SoftTimer **m_prevNextPtr{}; // the pointer that points at this timer, nullptr when not in a list
+    Ulong m_expiry{};            // in wheel ticks
+};
+
+/// Hierarchical timing wheel that runs many SoftTimers off one periodic TickTimer. Every level has wheelSlots slots, each
+/// slot of a level covering wheelSlots ticks of the level below. Timers move down a level when their slot comes up, and
+/// expired timers are handed to a WorkQueue in one batch per tick, so their callbacks run on its thread. The wheel must
+/// not be destroyed while the batch is pending.
+class TimerWheel
+{
+  public:
+    static constexpr Uint slotBits{6};
+    static constexpr Uint wheelSlots{1U << slotBits};
+    static constexpr Uint levels{4};
+    static constexpr Ulong range{Ulong{1} << (slotBits * levels)}; ///< ticks; longer timeouts take several rounds
+
+    /// \param workQueue queue the callbacks run on
+    explicit TimerWheel(WorkQueueBase &workQueue, const std::string_view name = "timerWheel");
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /// starts a timer, or restarts it if it is active. May be called from timer callbacks and ISRs.
+    template <typename Rep, typename Period> void start(SoftTimer &timer, const std::chrono::duration<Rep, Period> &timeout);
+
+    /// May be called from timer callbacks and ISRs.
+    /// \return false if the timer was not active
+    bool cancel(SoftTimer &timer);
+
+    /// \return number of active timers
+    Ulong active() const;
+
+  private:
+    void start(SoftTimer &timer, const Ulong ticks);
+    void insert(SoftTimer &timer);
+    void advance();
+    void cascade(const Uint level);
+    void dispatch();
+    void expire(SoftTimer &timer);
+    void remove(SoftTimer &timer);
+
+    static void link(SoftTimer *&headPtr, SoftTimer &timer);
+    static void unlink(SoftTimer &timer);
+
+    WorkQueueBase &m_workQueue;
+    WorkItem m_dispatchItem;
+    std::array<std::array<SoftTimer *, wheelSlots>, levels> m_wheel{};
+    SoftTimer *m_expired{}; // timers waiting for their callback, in expiry order
+    SoftTimer **m_expiredTailPtr{std::addressof(m_expired)};
+    Ulong m_now{};          // wheel ticks since construction
+    Ulong m_active{};
+    TickTimer m_tickTimer;
+};
+
+template <typename Rep, typename Period> void TimerWheel::start(SoftTimer &timer, const std::chrono::duration<Rep, Period> &timeout)
+{
+    start(timer, TickTimer::ticks(timeout));
+}
+} // namespace ThreadX
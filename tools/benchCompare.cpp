@@ -0,0 +1,122 @@
+// Compares benchmark results with a stored baseline and flags regressions. Both files hold the CSV lines printed by the
+// benchmarks (benchmark,case,value,unit). Values in units per second are better when higher, all others when lower.
+// usage: benchCompare [--tolerance PERCENT] baseline.csv results.csv
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+using Key = std::tuple<std::string, std::string, std::string>; // benchmark, case, unit
+using Results = std::map<Key, double>;
+
+constexpr double infinity{std::numeric_limits<double>::infinity()};
+
+std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream{line};
+    for (std::string field; std::getline(stream, field, ',');)
+    {
+        fields.push_back(field);
+    }
+
+    return fields;
+}
+
+bool parse(const char *const fileName, Results &results)
+{
+    std::ifstream file{fileName};
+    if (not file)
+    {
+        std::cerr << "cannot open " << fileName << '\n';
+        return false;
+    }
+
+    // lines other than results, such as the header and console output of the target, are skipped.
+    for (std::string line; std::getline(file, line);)
+    {
+        if (const auto fields{split(line)}; fields.size() == 4 and fields[0] != "benchmark")
+        {
+            try
+            {
+                results[Key{fields[0], fields[1], fields[3]}] = std::stod(fields[2]);
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+    }
+
+    return true;
+}
+
+bool higherIsBetter(const std::string_view unit)
+{
+    return unit.ends_with("/s");
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    double tolerance{5.0};
+    std::vector<const char *> fileNames;
+    for (int arg{1}; arg < argc; ++arg)
+    {
+        if (std::string_view{argv[arg]} == "--tolerance" and arg + 1 < argc)
+        {
+            tolerance = std::stod(argv[++arg]);
+        }
+        else
+        {
+            fileNames.push_back(argv[arg]);
+        }
+    }
+
+    if (fileNames.size() != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [--tolerance PERCENT] baseline.csv results.csv\n";
+        return 2;
+    }
+
+    Results baseline;
+    Results results;
+    if (not parse(fileNames[0], baseline) or not parse(fileNames[1], results))
+    {
+        return 2;
+    }
+
+    size_t regressions{};
+    std::printf("%-16s %-36s %12s %12s %8s\n", "benchmark", "case", "baseline", "result", "change");
+    for (const auto &[key, value] : results)
+    {
+        const auto &[benchmark, testCase, unit]{key};
+        const auto found{baseline.find(key)};
+        if (found == baseline.end())
+        {
+            std::printf("%-16s %-36s %12s %12.1f %8s  new\n", benchmark.c_str(), testCase.c_str(), "-", value, "");
+            continue;
+        }
+
+        const auto reference{found->second};
+        // a change from a baseline of 0 has no percentage, so it is beyond any tolerance. The change is relative to the size
+        // of the baseline, so that a higher value is a positive change for negative baselines too.
+        const auto change{reference != 0.0 ? (value - reference) / std::abs(reference) * 100.0 : value > 0.0 ? infinity : value < 0.0 ? -infinity : 0.0};
+        const bool regression{higherIsBetter(unit) ? change < -tolerance : change > tolerance};
+        regressions += regression ? 1 : 0;
+        std::printf("%-16s %-36s %12.1f %12.1f %+7.1f%%%s\n", benchmark.c_str(), testCase.c_str(), reference, value, change, regression ? "  regression" : "");
+    }
+
+    std::printf("\n%zu regressions beyond %.1f%%\n", regressions, tolerance);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+// Reads the CSV written by ThreadX::ThreadProfiler::report() and prints suggested priorities, preemption-thresholds and
+// the expected reduction in context switches.
+// usage: rmaReport [--highest-priority N] [--priority-step N] profile.csv
+
+#include "rateMonotonic.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using namespace ThreadX::RateMonotonic;
+
+std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream{line};
+    for (std::string field; std::getline(stream, field, ',');)
+    {
+        fields.push_back(field);
+    }
+
+    return fields;
+}
+
+bool parse(std::istream &input, std::vector<Task> &tasks, double &unitsPerSecond)
+{
+    constexpr std::string_view unitsPrefix{"# time units per second: "};
+
+    for (std::string line; std::getline(input, line);)
+    {
+        if (line.starts_with(unitsPrefix))
+        {
+            unitsPerSecond = std::stod(line.substr(unitsPrefix.size()));
+            continue;
+        }
+
+        if (line.empty() or line.starts_with('#') or line.starts_with("name,"))
+        {
+            continue;
+        }
+
+        const auto fields{split(line)};
+        if (fields.size() != 8)
+        {
+            std::cerr << "malformed line: " << line << '\n';
+            return false;
+        }
+
+        tasks.push_back({.name = fields[0],
+                         .period = std::stoull(fields[3]),
+                         .wcet = std::stoull(fields[4]),
+                         .blocking = std::stoull(fields[5]),
+                         .priority = unsigned(std::stoul(fields[1])),
+                         .threshold = unsigned(std::stoul(fields[2])),
+                         .preemptions = std::stoull(fields[7])});
+    }
+
+    return true;
+}
+
+void print(const std::vector<Task> &tasks, const Report &report, const double unitsPerSecond)
+{
+    std::printf("utilisation %.1f%%, %s\n\n", report.utilisation * 100.0, report.schedulable ? "schedulable" : "NOT schedulable");
+    std::printf("%-20s %10s %10s %10s %5s %5s %5s %5s %10s %10s\n", "thread", "period", "wcet", "response", "prio", "new", "pt", "new", "preempt", "expected");
+
+    for (const auto &result : report.tasks)
+    {
+        const auto &task{tasks[result.index]};
+        // the analysis gives up on a task whose busy period does not end.
+        const auto response{result.responseTime == ThreadX::RateMonotonic::Time(-1) ? std::string{"unbounded"} : std::to_string(result.responseTime)};
+
+        std::printf("%-20s %10llu %10llu %10s %5u %5u %5u %5u %10llu %10llu%s\n", result.name.c_str(), static_cast<unsigned long long>(result.period), static_cast<unsigned long long>(task.wcet),
+                    response.c_str(), task.priority, result.priority, task.threshold, result.threshold, static_cast<unsigned long long>(result.measuredPreemptions),
+                    static_cast<unsigned long long>(result.expectedPreemptions), result.schedulable ? "" : "  deadline miss");
+    }
+
+    if (report.schedulable and report.contextSwitchRate > 0.0)
+    {
+        std::printf("\ncontext switches per second: %.1f with thresholds equal to priorities, %.1f with the suggested thresholds (%.1f%% fewer)\n", report.contextSwitchRate * unitsPerSecond,
+                    report.thresholdContextSwitchRate * unitsPerSecond, (1.0 - report.thresholdContextSwitchRate / report.contextSwitchRate) * 100.0);
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    unsigned highestPriority{1};
+    unsigned priorityStep{1};
+    const char *fileName{};
+
+    for (int arg{1}; arg < argc; ++arg)
+    {
+        const std::string_view option{argv[arg]};
+        if (option == "--highest-priority" and arg + 1 < argc)
+        {
+            highestPriority = unsigned(std::stoul(argv[++arg]));
+        }
+        else if (option == "--priority-step" and arg + 1 < argc)
+        {
+            priorityStep = unsigned(std::stoul(argv[++arg]));
+        }
+        else
+        {
+            fileName = argv[arg];
+        }
+    }
+
+    if (not fileName)
+    {
+        std::cerr << "usage: " << argv[0] << " [--highest-priority N] [--priority-step N] profile.csv\n";
+        return 2;
+    }
+
+    std::ifstream file{fileName};
+    if (not file)
+    {
+        std::cerr << "cannot open " << fileName << '\n';
+        return 2;
+    }
+
+    std::vector<Task> tasks;
+    double unitsPerSecond{1.0};
+    if (not parse(file, tasks, unitsPerSecond))
+    {
+        return 2;
+    }
+
+    const auto report{analyse(tasks, highestPriority, priorityStep)};
+    print(tasks, report, unitsPerSecond);
+
+    return report.schedulable ? 0 : 1;
+}
@@ -0,0 +1,531 @@
+// Converts a trace buffer filled by ThreadX::Trace, as dumped from the target, to Chrome trace event JSON, which
+// chrome://tracing and the Perfetto UI open. Every thread gets a timeline of when it runs, named from the object
+// registry, every ISR id a timeline of its isrEnterInsert() to isrExitInsert() spans, and every other event is an
+// instant on the timeline of the thread or ISR it happened in, with the objects it refers to named.
+// A file written by ThreadX::TraceStream is read too: its header is marked, and its entries run to the end of the file,
+// or to the stream length in the header where the sink recorded one. Where the stream dropped entries, the timeline
+// closes up and shows a gap instant.
+// usage: traceExport [--frequency HZ] trace.trx [trace.json]
+// HZ is the frequency of the trace time stamps, 1000000 by default. Without trace.json the output goes to stdout.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr std::uint32_t headerId{0x54585442}; // "TXTB"
+constexpr std::uint32_t streamMarker{0x5354524D}; // "STRM", in the first reserved header word
+constexpr std::uint32_t streamGap{0x47415020};    // "GAP ", id of the entry a stream has where entries were dropped
+constexpr std::uint32_t isrContext{0xFFFFFFFF};
+constexpr std::uint32_t initialisationContext{0xF0F0F0F0};
+constexpr size_t headerSize{48};
+constexpr size_t entrySize{32};
+constexpr size_t objectEntrySize{16}; // without the name
+constexpr std::uint64_t isrTrack{0x100000000};
+
+enum EventId : std::uint32_t
+{
+    threadResume = 1,
+    threadSuspend = 2,
+    isrEnter = 3,
+    isrExit = 4,
+    userEventStart = 4096
+};
+
+constexpr auto eventNames{std::to_array<std::pair<std::uint32_t, std::string_view>>({
+    {1, "resume"},
+    {2, "suspend"},
+    {3, "isrEnter"},
+    {4, "isrExit"},
+    {5, "timeSlice"},
+    {6, "running"},
+    {10, "tx_block_allocate"},
+    {11, "tx_block_pool_create"},
+    {12, "tx_block_pool_delete"},
+    {13, "tx_block_pool_info_get"},
+    {14, "tx_block_pool_performance_info_get"},
+    {15, "tx_block_pool_performance_system_info_get"},
+    {16, "tx_block_pool_prioritize"},
+    {17, "tx_block_release"},
+    {20, "tx_byte_allocate"},
+    {21, "tx_byte_pool_create"},
+    {22, "tx_byte_pool_delete"},
+    {23, "tx_byte_pool_info_get"},
+    {24, "tx_byte_pool_performance_info_get"},
+    {25, "tx_byte_pool_performance_system_info_get"},
+    {26, "tx_byte_pool_prioritize"},
+    {27, "tx_byte_release"},
+    {30, "tx_event_flags_create"},
+    {31, "tx_event_flags_delete"},
+    {32, "tx_event_flags_get"},
+    {33, "tx_event_flags_info_get"},
+    {34, "tx_event_flags_performance_info_get"},
+    {35, "tx_event_flags_performance_system_info_get"},
+    {36, "tx_event_flags_set"},
+    {37, "tx_event_flags_set_notify"},
+    {40, "tx_interrupt_control"},
+    {50, "tx_mutex_create"},
+    {51, "tx_mutex_delete"},
+    {52, "tx_mutex_get"},
+    {53, "tx_mutex_info_get"},
+    {54, "tx_mutex_performance_info_get"},
+    {55, "tx_mutex_performance_system_info_get"},
+    {56, "tx_mutex_prioritize"},
+    {57, "tx_mutex_put"},
+    {60, "tx_queue_create"},
+    {61, "tx_queue_delete"},
+    {62, "tx_queue_flush"},
+    {63, "tx_queue_front_send"},
+    {64, "tx_queue_info_get"},
+    {65, "tx_queue_performance_info_get"},
+    {66, "tx_queue_performance_system_info_get"},
+    {67, "tx_queue_prioritize"},
+    {68, "tx_queue_receive"},
+    {69, "tx_queue_send"},
+    {70, "tx_queue_send_notify"},
+    {80, "tx_semaphore_ceiling_put"},
+    {81, "tx_semaphore_create"},
+    {82, "tx_semaphore_delete"},
+    {83, "tx_semaphore_get"},
+    {84, "tx_semaphore_info_get"},
+    {85, "tx_semaphore_performance_info_get"},
+    {86, "tx_semaphore_performance_system_info_get"},
+    {87, "tx_semaphore_prioritize"},
+    {88, "tx_semaphore_put"},
+    {89, "tx_semaphore_put_notify"},
+    {100, "tx_thread_create"},
+    {101, "tx_thread_delete"},
+    {102, "tx_thread_entry_exit_notify"},
+    {103, "tx_thread_identify"},
+    {104, "tx_thread_info_get"},
+    {105, "tx_thread_performance_info_get"},
+    {106, "tx_thread_performance_system_info_get"},
+    {107, "tx_thread_preemption_change"},
+    {108, "tx_thread_priority_change"},
+    {109, "tx_thread_relinquish"},
+    {110, "tx_thread_reset"},
+    {111, "tx_thread_resume"},
+    {112, "tx_thread_sleep"},
+    {113, "tx_thread_stack_error_notify"},
+    {114, "tx_thread_suspend"},
+    {115, "tx_thread_terminate"},
+    {116, "tx_thread_time_slice_change"},
+    {117, "tx_thread_wait_abort"},
+    {120, "tx_time_get"},
+    {121, "tx_time_set"},
+    {130, "tx_timer_activate"},
+    {131, "tx_timer_change"},
+    {132, "tx_timer_create"},
+    {133, "tx_timer_deactivate"},
+    {134, "tx_timer_delete"},
+    {135, "tx_timer_info_get"},
+    {136, "tx_timer_performance_info_get"},
+    {137, "tx_timer_performance_system_info_get"},
+})};
+
+struct Entry
+{
+    std::uint32_t context; // thread pointer, isrContext or initialisationContext
+    std::uint32_t priority;
+    std::uint32_t id;
+    std::uint32_t timeStamp;
+    std::array<std::uint32_t, 4> info;
+};
+
+struct Object
+{
+    unsigned type; // 1 for threads
+    std::string name;
+};
+
+struct Trace
+{
+    std::uint32_t timeStampMask;
+    std::map<std::uint32_t, Object> objects; // by address on the target
+    std::vector<Entry> entries;              // oldest first
+};
+
+/// Reads the words of the dump, which are in the byte order of the target. The header id tells which it is.
+class Reader
+{
+  public:
+    explicit Reader(const std::vector<unsigned char> &data) : m_data{data}
+    {
+    }
+
+    bool fits(const size_t offset, const size_t size) const
+    {
+        return offset <= m_data.size() and size <= m_data.size() - offset;
+    }
+
+    std::uint32_t word(const size_t offset) const
+    {
+        std::uint32_t value{};
+        for (size_t byte{}; byte < 4; ++byte)
+        {
+            value |= std::uint32_t{m_data[offset + (m_bigEndian ? 3 - byte : byte)]} << (8 * byte);
+        }
+
+        return value;
+    }
+
+    std::uint16_t halfWord(const size_t offset) const
+    {
+        return m_bigEndian ? std::uint16_t(m_data[offset] << 8 | m_data[offset + 1]) : std::uint16_t(m_data[offset + 1] << 8 | m_data[offset]);
+    }
+
+    std::string string(const size_t offset, const size_t size) const
+    {
+        const auto begin{m_data.begin() + std::ptrdiff_t(offset)};
+        return {begin, std::find(begin, begin + std::ptrdiff_t(size), 0)};
+    }
+
+    /// \return false if the header id is not there in either byte order
+    bool detectByteOrder()
+    {
+        m_bigEndian = false;
+        if (fits(0, headerSize) and word(0) != headerId)
+        {
+            m_bigEndian = true;
+        }
+
+        return fits(0, headerSize) and word(0) == headerId;
+    }
+
+  private:
+    const std::vector<unsigned char> &m_data;
+    bool m_bigEndian{};
+};
+
+std::optional<Trace> parse(const std::vector<unsigned char> &data)
+{
+    Reader reader{data};
+    if (not reader.detectByteOrder())
+    {
+        std::cerr << "no trace header\n";
+        return std::nullopt;
+    }
+
+    // the header holds target addresses, relative to the base address of the trace memory.
+    Trace trace{.timeStampMask = reader.word(4), .objects = {}, .entries = {}};
+    const auto base{reader.word(8)};
+    const size_t registryStart{reader.word(12) - base};
+    const size_t nameSize{reader.halfWord(18)};
+    const size_t registryEnd{reader.word(20) - base};
+    const size_t bufferStart{reader.word(24) - base};
+    const size_t bufferEnd{reader.word(28) - base};
+    const size_t bufferCurrent{reader.word(32) - base};
+    const bool stream{reader.word(36) == streamMarker};
+    const size_t streamLength{stream ? reader.word(40) : 0}; // 0 if the stream runs to the end of the file
+
+    // the entries of a stream run to the end of the file, or its recorded length, rather than fill a ring.
+    const auto ringFits{reader.fits(bufferStart, bufferEnd - bufferStart) and bufferCurrent >= bufferStart and bufferCurrent <= bufferEnd};
+    if (not reader.fits(registryStart, registryEnd - registryStart) or (stream ? registryEnd > bufferStart : not ringFits))
+    {
+        std::cerr << "trace header does not match the file size\n";
+        return std::nullopt;
+    }
+
+    for (auto offset{registryStart}; offset + objectEntrySize + nameSize <= registryEnd; offset += objectEntrySize + nameSize)
+    {
+        // an entry in use is not available
+        if (data[offset] == 0)
+        {
+            trace.objects[reader.word(offset + 4)] = Object{.type = data[offset + 1], .name = reader.string(offset + objectEntrySize, nameSize)};
+        }
+    }
+
+    // the oldest entry is the one the next event overwrites. Entries never written have id 0.
+    auto read = [&](const size_t begin, const size_t end) {
+        for (auto offset{begin}; offset + entrySize <= end; offset += entrySize)
+        {
+            Entry entry{.context = reader.word(offset),
+                        .priority = reader.word(offset + 4),
+                        .id = reader.word(offset + 8),
+                        .timeStamp = reader.word(offset + 12),
+                        .info = {reader.word(offset + 16), reader.word(offset + 20), reader.word(offset + 24), reader.word(offset + 28)}};
+            if (entry.id != 0)
+            {
+                trace.entries.push_back(entry);
+            }
+        }
+    };
+
+    if (stream)
+    {
+        read(bufferStart, streamLength > 0 ? std::min(streamLength, data.size()) : data.size());
+    }
+    else
+    {
+        read(bufferCurrent, bufferEnd);
+        read(bufferStart, bufferCurrent);
+    }
+
+    return trace;
+}
+
+std::string escape(const std::string_view text)
+{
+    std::string escaped;
+    for (const auto character : text)
+    {
+        if (character == '"' or character == '\\')
+        {
+            escaped += '\\';
+            escaped += character;
+        }
+        else if (static_cast<unsigned char>(character) < 0x20)
+        {
+            std::array<char, 8> code{};
+            std::snprintf(code.data(), code.size(), "\\u%04x", unsigned(character));
+            escaped += code.data();
+        }
+        else
+        {
+            escaped += character;
+        }
+    }
+
+    return escaped;
+}
+
+std::string eventName(const std::uint32_t id)
+{
+    if (const auto found{std::ranges::find(eventNames, id, &std::pair<std::uint32_t, std::string_view>::first)}; found != eventNames.end())
+    {
+        return std::string{found->second};
+    }
+
+    return (id >= userEventStart ? "user " : "event ") + std::to_string(id);
+}
+
+class ChromeWriter
+{
+  public:
+    ChromeWriter(std::ostream &output, const Trace &trace, const double frequency) : m_output{output}, m_trace{trace}, m_frequency{frequency}
+    {
+    }
+
+    void write()
+    {
+        m_output << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        metadata("process_name", 0, "ThreadX");
+        metadata("thread_name", initialisationContext, "initialisation");
+        for (const auto &[address, object] : m_trace.objects)
+        {
+            if (object.type == 1)
+            {
+                metadata("thread_name", address, object.name);
+            }
+        }
+
+        std::uint64_t elapsed{};
+        std::optional<std::uint32_t> previous;
+        for (const auto &entry : m_trace.entries)
+        {
+            // the time across a gap is unknown, so it counts as none.
+            if (previous and entry.id != streamGap)
+            {
+                elapsed += (entry.timeStamp - *previous) & m_trace.timeStampMask;
+            }
+
+            previous = entry.timeStamp;
+            process(entry, double(elapsed) * 1e6 / m_frequency);
+        }
+
+        if (m_running and m_trace.entries.size() > 0)
+        {
+            span(*m_running, m_runningSince, double(elapsed) * 1e6 / m_frequency);
+        }
+
+        m_output << "\n]}\n";
+    }
+
+  private:
+    void process(const Entry &entry, const double time)
+    {
+        // an entry of a thread shows that it runs, also when the switch to it is older than the trace.
+        if (entry.context != isrContext and entry.context != initialisationContext and entry.context != 0 and m_running != entry.context)
+        {
+            switchTo(entry.context, time);
+        }
+
+        switch (entry.id)
+        {
+        case isrEnter:
+            m_isrs.push_back(entry.info[1]);
+            if (m_isrNames.insert(entry.info[1]).second)
+            {
+                metadata("thread_name", isrTrack + entry.info[1], "ISR " + std::to_string(entry.info[1]));
+            }
+            event("B", time, isrTrack + entry.info[1], "ISR " + std::to_string(entry.info[1]), "");
+            break;
+
+        case isrExit:
+            event("E", time, isrTrack + entry.info[1], "ISR " + std::to_string(entry.info[1]), "");
+            if (not m_isrs.empty())
+            {
+                m_isrs.pop_back();
+            }
+            break;
+
+        case streamGap:
+            switchTo(0, time);
+            m_isrs.clear();
+            event("i", time, 0, "gap", "\"droppedHalves\":" + std::to_string(entry.info[0]));
+            break;
+
+        default:
+            event("i", time, track(entry), eventName(entry.id), arguments(entry));
+            break;
+        }
+
+        // the last information field of a resume or suspend is the thread that runs next, 0 for none.
+        if ((entry.id == threadResume or entry.id == threadSuspend) and m_running != entry.info[3])
+        {
+            switchTo(entry.info[3], time);
+        }
+    }
+
+    void switchTo(const std::uint32_t thread, const double time)
+    {
+        if (m_running and time > m_runningSince)
+        {
+            span(*m_running, m_runningSince, time);
+        }
+
+        m_running = thread != 0 ? std::optional{thread} : std::nullopt;
+        m_runningSince = time;
+    }
+
+    std::uint64_t track(const Entry &entry) const
+    {
+        if (entry.context == isrContext)
+        {
+            return m_isrs.empty() ? isrTrack : isrTrack + m_isrs.back();
+        }
+
+        return entry.context;
+    }
+
+    std::string arguments(const Entry &entry) const
+    {
+        std::string text;
+        for (size_t field{}; field < entry.info.size(); ++field)
+        {
+            std::array<char, 16> value{};
+            std::snprintf(value.data(), value.size(), "0x%08x", unsigned(entry.info[field]));
+            const auto found{m_trace.objects.find(entry.info[field])};
+            text += (field > 0 ? ",\"info" : "\"info") + std::to_string(field + 1) + "\":\"" + (found != m_trace.objects.end() ? escape(found->second.name) : value.data()) + '"';
+        }
+
+        return text;
+    }
+
+    void span(const std::uint32_t thread, const double start, const double end)
+    {
+        const auto found{m_trace.objects.find(thread)};
+        separate();
+        m_output << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << thread << ",\"ts\":" << start << ",\"dur\":" << end - start << ",\"name\":\"" << (found != m_trace.objects.end() ? escape(found->second.name) : "thread") << "\"}";
+    }
+
+    void event(const std::string_view phase, const double time, const std::uint64_t tid, const std::string &name, const std::string &arguments)
+    {
+        separate();
+        m_output << "{\"ph\":\"" << phase << "\",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << time << ",\"name\":\"" << escape(name) << '"';
+        if (phase == "i")
+        {
+            m_output << ",\"s\":\"t\"";
+        }
+
+        m_output << ",\"args\":{" << arguments << "}}";
+    }
+
+    void metadata(const std::string_view kind, const std::uint64_t tid, const std::string_view name)
+    {
+        separate();
+        m_output << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << tid << ",\"name\":\"" << kind << "\",\"args\":{\"name\":\"" << escape(name) << "\"}}";
+    }
+
+    void separate()
+    {
+        if (m_events++ > 0)
+        {
+            m_output << ",\n";
+        }
+    }
+
+    std::ostream &m_output;
+    const Trace &m_trace;
+    const double m_frequency;
+    size_t m_events{};
+    std::optional<std::uint32_t> m_running;
+    double m_runningSince{};
+    std::vector<std::uint32_t> m_isrs; // ISRs entered and not exited, innermost last
+    std::set<std::uint32_t> m_isrNames;
+};
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    double frequency{1e6};
+    std::vector<const char *> fileNames;
+    for (int arg{1}; arg < argc; ++arg)
+    {
+        if (std::string_view{argv[arg]} == "--frequency" and arg + 1 < argc)
+        {
+            frequency = std::stod(argv[++arg]);
+        }
+        else
+        {
+            fileNames.push_back(argv[arg]);
+        }
+    }
+
+    if (fileNames.empty() or fileNames.size() > 2 or frequency <= 0.0)
+    {
+        std::cerr << "usage: " << argv[0] << " [--frequency HZ] trace.trx [trace.json]\n";
+        return 2;
+    }
+
+    std::ifstream input{fileNames[0], std::ios::binary};
+    if (not input)
+    {
+        std::cerr << "cannot open " << fileNames[0] << '\n';
+        return 2;
+    }
+
+    const std::vector<unsigned char> data{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+    const auto trace{parse(data)};
+    if (not trace)
+    {
+        return 1;
+    }
+
+    std::ofstream file;
+    if (fileNames.size() == 2)
+    {
+        file.open(fileNames[1]);
+        if (not file)
+        {
+            std::cerr << "cannot write " << fileNames[1] << '\n';
+            return 2;
+        }
+    }
+
+    ChromeWriter{fileNames.size() == 2 ? file : std::cout, *trace, frequency}.write();
+    std::cerr << trace->entries.size() << " events, " << trace->objects.size() << " objects\n";
+    return 0;
+}
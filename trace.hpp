@@ -5,6 +5,7 @@
 #include "fxCommon.hpp"
 #include "txCommon.hpp"
 #include <array>
+#include <span>
 #include <type_traits> // for std::to_underlying
 
 namespace ThreadX
@@ -90,8 +91,11 @@ template <Ulong Size> class Trace
     static auto userEventInsert(const Ulong eventID, const Ulong infoField1, const Ulong infoField2,
                                 const Ulong infoField3, const Ulong infoField4);
 
+    /// trace memory, starting with the TX_TRACE_HEADER
+    std::span<Uchar, Size> buffer();
+
   private:
-    std::array<Uchar, Size> m_trace{};
+    alignas(Ulong) std::array<Uchar, Size> m_trace{};
 };
 
 template <Ulong Size> Trace<Size>::Trace(const Ulong registryEntries)
@@ -143,6 +147,11 @@ auto Trace<Size>::userEventInsert(
     return Error{Native::tx_trace_user_event_insert(eventID, infoField1, infoField2, infoField3, infoField4)};
 }
 
+template <Ulong Size> std::span<Uchar, Size> Trace<Size>::buffer()
+{
+    return m_trace;
+}
+
 using TraceBufFullNotifyCallback = void (*)(void *);
 
 inline auto registerbufFullNotifyCallback(const TraceBufFullNotifyCallback bufferFullNotifyCallback)
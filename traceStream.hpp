@@ -0,0 +1,476 @@
+#pragma once
+
+#ifdef TX_ENABLE_EVENT_TRACE
+
+#include "file.hpp"
+#include "kernel.hpp"
+#include "media.hpp"
+#include "memoryPool.hpp"
+#include "thread.hpp"
+#include "tickTimer.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace ThreadX::Native
+{
+extern "C" {
+#include "tx_trace.h"
+}
+} // namespace ThreadX::Native
+
+namespace ThreadX
+{
+/// written to the first reserved word of the header at the start of a stream, so that tools/traceExport reads the
+/// entries to the end of the file rather than as a ring.
+inline constexpr Ulong traceStreamMarker{0x5354524D}; // "STRM"
+
+/// event id of the entry a stream has where halves of the trace buffer were dropped. The first information field holds
+/// their number, and the time stamp is that of the entry after the gap.
+inline constexpr Ulong traceStreamGapId{0x47415020}; // "GAP "
+
+/// Destination of a TraceStream. A stream is a copy of the trace header and object registry followed by the entries in
+/// the order they were written.
+class TraceSink
+{
+  public:
+    /// \return true if size more bytes fit into the current stream
+    virtual bool fits(const Ulong size) const = 0;
+
+    /// ends the current stream, if there is one, and starts a new one.
+    virtual FileX::Error open() = 0;
+
+    virtual FileX::Error write(const std::span<std::byte> data) = 0;
+
+  protected:
+    ~TraceSink() = default;
+};
+
+/// Writes streams to the files baseName0.trx, baseName1.trx and so on, moving to the next file when the next half of
+/// the trace buffer would take one past maxFileSize. After the last file it starts over with the first, so the oldest
+/// trace is overwritten. The media is flushed after every half, so a power loss costs at most the half being written.
+template <FileX::MediaSectorSize N> class TraceFileSink : public TraceSink
+{
+  public:
+    explicit TraceFileSink(FileX::Media<N> &media, const std::string_view baseName, const Ulong maxFileSize, const Uint maxFiles = 2);
+
+    bool fits(const Ulong size) const final;
+    FileX::Error open() final;
+    FileX::Error write(const std::span<std::byte> data) final;
+
+  private:
+    FileX::Media<N> &m_media;
+    const std::string_view m_baseName;
+    const Ulong m_maxFileSize;
+    const Uint m_maxFiles;
+    Uint m_nextFile{};
+    Ulong m_fileSize{};
+    std::array<char, 32> m_fileName{};
+    std::optional<FileX::File> m_file;
+};
+
+/// Writes streams to the sectors from firstSector on, bypassing the file system, e.g. to space reserved for the trace
+/// outside the partition. A stream starts over at firstSector when the next half does not fit, and the sectors past its
+/// end still hold the end of the stream before, so the length written is kept in the third reserved word of the header,
+/// rewritten after every write that completes a sector. Up to a sector of the latest entries is held until the next half.
+template <FileX::MediaSectorSize N> class TraceSectorSink : public TraceSink
+{
+  public:
+    explicit TraceSectorSink(FileX::Media<N> &media, const Ulong firstSector, const Ulong sectors);
+
+    bool fits(const Ulong size) const final;
+    FileX::Error open() final;
+    FileX::Error write(std::span<std::byte> data) final;
+
+  private:
+    static constexpr auto sectorSize{std::to_underlying(N)};
+
+    /// rewrites the first sector with the length of the stream on the media.
+    FileX::Error recordLength();
+
+    FileX::Media<N> &m_media;
+    const Ulong m_firstSector;
+    const Ulong m_sectors;
+    Ulong m_nextSector;
+    Ulong m_recordedLength{};
+    size_t m_filled{}; // bytes of m_sector not written yet
+    std::array<std::byte, sectorSize> m_sector{};
+    std::array<std::byte, sectorSize> m_headerSector{}; // first sector of the stream
+};
+
+/// Counters of a TraceStream, in halves of the trace buffer.
+struct TraceStreamMetrics
+{
+    Ulong written;     ///< halves written to the sink
+    Ulong dropped;     ///< halves that tracing overwrote before or while they were copied, or that failed to write
+    Ulong streams;     ///< files or sector ranges started
+    Ulong writeErrors; ///< failed writes, after which the next half starts a new stream
+};
+
+/// Trace that streams to a TraceSink rather than keeping only the latest entries, to capture hours of trace.
+/// The entries of the trace buffer are split into two halves: while tracing fills one, a drainer thread copies the other
+/// and writes the copy, unless tracing came back to the half while it was copied.
+/// The drainer polls the trace position, as the buffer full notification comes from inside the kernel's trace insertion,
+/// where no service may be called. Give it a priority below the traced threads and a poll period shorter than the time
+/// tracing takes to fill a half. If the drainer falls behind, the halves it missed are counted as dropped and it goes
+/// on with the latest complete half, so the stream has a gap, marked by a traceStreamGapId entry, rather than stalling.
+/// Only one trace can be enabled.
+/// \tparam Size trace buffer size, including the header and the object registry
+/// \tparam Pool byte pool for the drainer's stack and the copy of a half
+template <Ulong Size, class Pool> class TraceStream
+{
+    static_assert(std::is_base_of_v<BytePoolBase, Pool>);
+
+  public:
+    explicit TraceStream(const Ulong registryEntries, TraceSink &sink, Pool &pool, const Uint priority, const TickTimer::Duration pollPeriod = TickTimer::Duration{10}, const Ulong stackSize = minimumStackSize);
+
+    TraceStream(const TraceStream &) = delete;
+    TraceStream &operator=(const TraceStream &) = delete;
+
+    /// for the event filters and inserts
+    Trace<Size> &trace();
+
+    TraceStreamMetrics metrics() const;
+
+  private:
+    class Drainer : public Thread<Pool>
+    {
+      public:
+        explicit Drainer(TraceStream &stream, Pool &pool, const Uint priority, const Ulong stackSize);
+
+      private:
+        void entryCallback() final;
+
+        TraceStream &m_stream;
+    };
+
+    [[noreturn]] void run();
+
+    /// copies the half of the entries.
+    /// \return the copy
+    std::span<std::byte> stage(const Ulong half);
+
+    /// writes the copy of a half, preceded by a gap marker if halves were dropped, after starting a stream if the
+    /// current one is full or failed.
+    FileX::Error write(const std::span<std::byte> data);
+
+    FileX::Error startStream();
+
+    /// \return number of the half tracing writes to, counted from the first half since the trace was enabled
+    Ulong writerHalf();
+
+    /// \return entries of the half, the second of which takes the odd entry
+    std::span<std::byte> entries(const Ulong half);
+
+    Native::TX_TRACE_HEADER &header();
+
+    static void bufferFullCallback(void *headerPtr);
+
+    static inline std::atomic<Ulong> m_laps; // times tracing wrapped to the first entry
+
+    Trace<Size> m_trace;
+    TraceSink &m_sink;
+    const TickTimer::Duration m_pollPeriod;
+    Ulong m_entriesOffset{};
+    Ulong m_entriesSize{};
+    Ulong m_halfSize{};
+    Ulong m_nextHalf{};
+    Ulong m_gap{}; // halves dropped since the last one written
+    bool m_streaming{};
+    std::atomic<Ulong> m_written;
+    std::atomic<Ulong> m_dropped;
+    std::atomic<Ulong> m_streams;
+    std::atomic<Ulong> m_writeErrors;
+    Allocation<Pool> m_staging; // the larger half is under half the buffer, which also holds the header
+    Drainer m_drainer;
+};
+
+template <FileX::MediaSectorSize N>
+TraceFileSink<N>::TraceFileSink(FileX::Media<N> &media, const std::string_view baseName, const Ulong maxFileSize, const Uint maxFiles)
+    : m_media{media}, m_baseName{baseName}, m_maxFileSize{maxFileSize}, m_maxFiles{maxFiles}
+{
+    assert(maxFiles > 0);
+}
+
+template <FileX::MediaSectorSize N> bool TraceFileSink<N>::fits(const Ulong size) const
+{
+    return m_file and m_fileSize + size <= m_maxFileSize;
+}
+
+template <FileX::MediaSectorSize N> FileX::Error TraceFileSink<N>::open()
+{
+    m_file.reset();
+    m_fileSize = 0;
+    std::snprintf(m_fileName.data(), m_fileName.size(), "%.*s%u.trx", int(m_baseName.size()), m_baseName.data(), unsigned(m_nextFile));
+    m_nextFile = (m_nextFile + 1) % m_maxFiles;
+
+    [[maybe_unused]] auto error{m_media.deleteFile(m_fileName.data())}; // notFound until the files are reused
+    error = m_media.createFile(m_fileName.data());
+    if (error != FileX::Error::success)
+    {
+        return error;
+    }
+
+    m_file.emplace(m_fileName.data(), m_media, FileX::OpenOption::write);
+    return FileX::Error::success;
+}
+
+template <FileX::MediaSectorSize N> FileX::Error TraceFileSink<N>::write(const std::span<std::byte> data)
+{
+    if (auto error{m_file->write(data)}; error != FileX::Error::success)
+    {
+        m_file.reset();
+        return error;
+    }
+
+    m_fileSize += data.size();
+    return m_media.flush();
+}
+
+template <FileX::MediaSectorSize N>
+TraceSectorSink<N>::TraceSectorSink(FileX::Media<N> &media, const Ulong firstSector, const Ulong sectors) : m_media{media}, m_firstSector{firstSector}, m_sectors{sectors}, m_nextSector{firstSector}
+{
+    assert(sectors > 0);
+}
+
+template <FileX::MediaSectorSize N> bool TraceSectorSink<N>::fits(const Ulong size) const
+{
+    return Ulong64{m_nextSector - m_firstSector} * sectorSize + m_filled + size <= Ulong64{m_sectors} * sectorSize;
+}
+
+template <FileX::MediaSectorSize N> FileX::Error TraceSectorSink<N>::open()
+{
+    m_nextSector = m_firstSector;
+    m_recordedLength = 0;
+    m_filled = 0;
+    return FileX::Error::success;
+}
+
+template <FileX::MediaSectorSize N> FileX::Error TraceSectorSink<N>::write(std::span<std::byte> data)
+{
+    while (not data.empty())
+    {
+        const auto size{std::min(data.size(), sectorSize - m_filled)};
+        std::memcpy(m_sector.data() + m_filled, data.data(), size);
+        m_filled += size;
+        data = data.subspan(size);
+
+        if (m_filled == sectorSize)
+        {
+            if (m_nextSector == m_firstSector)
+            {
+                m_headerSector = m_sector;
+            }
+
+            if (auto error{m_media.writeSector(m_nextSector, m_sector)}; error != FileX::Error::success)
+            {
+                return error;
+            }
+
+            ++m_nextSector;
+            m_filled = 0;
+        }
+    }
+
+    return recordLength();
+}
+
+template <FileX::MediaSectorSize N> FileX::Error TraceSectorSink<N>::recordLength()
+{
+    const Ulong length{(m_nextSector - m_firstSector) * sectorSize};
+    if (length == m_recordedLength)
+    {
+        return FileX::Error::success;
+    }
+
+    std::memcpy(m_headerSector.data() + offsetof(Native::TX_TRACE_HEADER, tx_trace_header_reserved3), &length, sizeof(length));
+    if (auto error{m_media.writeSector(m_firstSector, m_headerSector)}; error != FileX::Error::success)
+    {
+        return error;
+    }
+
+    m_recordedLength = length;
+    return FileX::Error::success;
+}
+
+template <Ulong Size, class Pool>
+TraceStream<Size, Pool>::TraceStream(const Ulong registryEntries, TraceSink &sink, Pool &pool, const Uint priority, const TickTimer::Duration pollPeriod, const Ulong stackSize)
+    : m_trace{registryEntries}, m_sink{sink}, m_pollPeriod{pollPeriod}, m_staging{pool, Size / 2}, m_drainer{*this, pool, priority, stackSize}
+{
+    const auto &traceHeader{header()};
+    m_entriesOffset = traceHeader.tx_trace_header_buffer_start_pointer - traceHeader.tx_trace_header_trace_base_address;
+    m_entriesSize = traceHeader.tx_trace_header_buffer_end_pointer - traceHeader.tx_trace_header_buffer_start_pointer;
+    m_halfSize = m_entriesSize / sizeof(Native::TX_TRACE_BUFFER_ENTRY) / 2 * sizeof(Native::TX_TRACE_BUFFER_ENTRY);
+    assert(m_halfSize > 0);
+
+    m_laps = 0;
+    [[maybe_unused]] auto error{registerbufFullNotifyCallback(bufferFullCallback)};
+    assert(error == Error::success);
+
+    // the drainer is created suspended so that it cannot run before the halves are known.
+    error = m_drainer.resume();
+    assert(error == Error::success);
+}
+
+template <Ulong Size, class Pool> Trace<Size> &TraceStream<Size, Pool>::trace()
+{
+    return m_trace;
+}
+
+template <Ulong Size, class Pool> TraceStreamMetrics TraceStream<Size, Pool>::metrics() const
+{
+    return TraceStreamMetrics{.written = m_written, .dropped = m_dropped, .streams = m_streams, .writeErrors = m_writeErrors};
+}
+
+template <Ulong Size, class Pool>
+TraceStream<Size, Pool>::Drainer::Drainer(TraceStream &stream, Pool &pool, const Uint priority, const Ulong stackSize)
+    : Thread<Pool>{"traceDrainer", pool, stackSize, {}, priority, priority, noTimeSlice, ThreadStartType::dontStart}, m_stream{stream}
+{
+}
+
+template <Ulong Size, class Pool> void TraceStream<Size, Pool>::Drainer::entryCallback()
+{
+    m_stream.run();
+}
+
+template <Ulong Size, class Pool> void TraceStream<Size, Pool>::run()
+{
+    while (true)
+    {
+        ThisThread::sleepFor(m_pollPeriod);
+
+        // a half is complete once tracing has moved on to the next, and stays intact until tracing comes back to it.
+        const auto writer{writerHalf()};
+        if (writer > m_nextHalf + 1)
+        {
+            m_dropped += writer - 1 - m_nextHalf;
+            m_gap += writer - 1 - m_nextHalf;
+            m_nextHalf = writer - 1;
+        }
+
+        if (writer == m_nextHalf + 1)
+        {
+            // tracing may come back to the half while it is copied, which the position tells once the copy is done.
+            const auto data{stage(m_nextHalf)};
+            if (writerHalf() > m_nextHalf + 1)
+            {
+                ++m_dropped;
+                ++m_gap;
+            }
+            else if (write(data) != FileX::Error::success)
+            {
+                ++m_writeErrors;
+                ++m_dropped;
+                ++m_gap;
+                m_streaming = false;
+            }
+            else
+            {
+                ++m_written;
+            }
+
+            ++m_nextHalf;
+        }
+    }
+}
+
+template <Ulong Size, class Pool> std::span<std::byte> TraceStream<Size, Pool>::stage(const Ulong half)
+{
+    const auto data{entries(half)};
+    std::memcpy(m_staging.get(), data.data(), data.size());
+    return {m_staging.get(), data.size()};
+}
+
+template <Ulong Size, class Pool> FileX::Error TraceStream<Size, Pool>::write(const std::span<std::byte> data)
+{
+    Native::TX_TRACE_BUFFER_ENTRY gap{};
+    const auto gapSize{m_gap > 0 ? sizeof(gap) : 0};
+    if (not m_streaming or not m_sink.fits(gapSize + data.size()))
+    {
+        if (auto error{startStream()}; error != FileX::Error::success)
+        {
+            return error;
+        }
+    }
+
+    if (m_gap > 0)
+    {
+        // the time across the gap is unknown, so the marker takes the time stamp of the first entry after it.
+        gap.tx_trace_buffer_entry_event_id = traceStreamGapId;
+        gap.tx_trace_buffer_entry_time_stamp = reinterpret_cast<const Native::TX_TRACE_BUFFER_ENTRY *>(data.data())->tx_trace_buffer_entry_time_stamp;
+        gap.tx_trace_buffer_entry_information_field_1 = m_gap;
+        if (auto error{m_sink.write(std::as_writable_bytes(std::span{&gap, 1}))}; error != FileX::Error::success)
+        {
+            return error;
+        }
+
+        m_gap = 0;
+    }
+
+    return m_sink.write(data);
+}
+
+template <Ulong Size, class Pool> FileX::Error TraceStream<Size, Pool>::startStream()
+{
+    m_streaming = false;
+    if (auto error{m_sink.open()}; error != FileX::Error::success)
+    {
+        return error;
+    }
+
+    // a copy of the registry of the time, so that every stream names its objects on its own
+    auto streamHeader{header()};
+    streamHeader.tx_trace_header_reserved2 = traceStreamMarker;
+    streamHeader.tx_trace_header_reserved3 = 0; // stream length, where the sink records it
+    if (auto error{m_sink.write(std::as_writable_bytes(std::span{&streamHeader, 1}))}; error != FileX::Error::success)
+    {
+        return error;
+    }
+
+    const auto registry{std::as_writable_bytes(m_trace.buffer().subspan(sizeof(streamHeader), m_entriesOffset - sizeof(streamHeader)))};
+    if (auto error{m_sink.write(registry)}; error != FileX::Error::success)
+    {
+        return error;
+    }
+
+    m_streaming = true;
+    ++m_streams;
+    return FileX::Error::success;
+}
+
+template <Ulong Size, class Pool> Ulong TraceStream<Size, Pool>::writerHalf()
+{
+    // the lap count is updated after the position wraps, which can only make the half seem older than it is.
+    Kernel::CriticalSection cs;
+    const auto &traceHeader{header()};
+    const Ulong position{traceHeader.tx_trace_header_buffer_current_pointer - traceHeader.tx_trace_header_buffer_start_pointer};
+    return 2 * m_laps + (position >= m_halfSize ? 1 : 0);
+}
+
+template <Ulong Size, class Pool> std::span<std::byte> TraceStream<Size, Pool>::entries(const Ulong half)
+{
+    const auto offset{m_entriesOffset + (half % 2) * m_halfSize};
+    const auto size{half % 2 == 0 ? m_halfSize : m_entriesSize - m_halfSize};
+    return std::as_writable_bytes(m_trace.buffer().subspan(offset, size));
+}
+
+template <Ulong Size, class Pool> Native::TX_TRACE_HEADER &TraceStream<Size, Pool>::header()
+{
+    return *reinterpret_cast<Native::TX_TRACE_HEADER *>(m_trace.buffer().data());
+}
+
+template <Ulong Size, class Pool> void TraceStream<Size, Pool>::bufferFullCallback([[maybe_unused]] void *headerPtr)
+{
+    ++m_laps;
+}
+} // namespace ThreadX
+#endif // TX_ENABLE_EVENT_TRACE
@@ -0,0 +1,89 @@
+#include "workQueue.hpp"
+#include <chrono>
+
+namespace ThreadX
+{
+WorkItem::WorkItem(const Callback &callback) : m_callback{callback}
+{
+}
+
+bool WorkItem::pending() const
+{
+    return m_pending.load(std::memory_order_relaxed);
+}
+
+WorkQueueBase::WorkQueueBase(const std::string_view name) : m_semaphore{name}
+{
+}
+
+bool WorkQueueBase::post(WorkItem &item)
+{
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    if (item.m_pending.exchange(true, std::memory_order_acquire))
+    {
+        m_coalesced.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item.m_postTime = HighResClock::now();
+
+    auto headPtr{m_head.load(std::memory_order_relaxed)};
+    do
+    {
+        item.m_next = headPtr;
+    } while (not m_head.compare_exchange_weak(headPtr, std::addressof(item), std::memory_order_release, std::memory_order_relaxed));
+
+    // a worker takes the whole list, so it is only woken for the first item.
+    if (not headPtr)
+    {
+        [[maybe_unused]] auto error{m_semaphore.release()};
+        assert(error == Error::success);
+    }
+
+    return true;
+}
+
+WorkQueueMetrics WorkQueueBase::metrics() const
+{
+    return WorkQueueMetrics{.posted = m_posted, .coalesced = m_coalesced, .executed = m_executed, .maxLatency = m_maxLatency};
+}
+
+void WorkQueueBase::resetMetrics()
+{
+    m_posted = 0;
+    m_coalesced = 0;
+    m_executed = 0;
+    m_maxLatency = 0;
+}
+
+void WorkQueueBase::run()
+{
+    while (true)
+    {
+        [[maybe_unused]] auto error{m_semaphore.acquire()};
+        assert(error == Error::success);
+
+        // the list is taken in one exchange, which cannot suffer from ABA, and reversed into posting order.
+        WorkItem *itemPtr{};
+        for (auto postedPtr{m_head.exchange(nullptr, std::memory_order_acquire)}; postedPtr;)
+        {
+            itemPtr = std::exchange(postedPtr, std::exchange(postedPtr->m_next, itemPtr));
+        }
+
+        while (itemPtr)
+        {
+            // once the item is no longer pending it can be posted again, which overwrites m_next.
+            auto &item{*std::exchange(itemPtr, itemPtr->m_next)};
+            const Ulong latency(std::chrono::duration_cast<std::chrono::microseconds>(HighResClock::now() - item.m_postTime).count());
+            item.m_pending.store(false, std::memory_order_release);
+
+            for (auto max{m_maxLatency.load(std::memory_order_relaxed)}; latency > max and not m_maxLatency.compare_exchange_weak(max, latency, std::memory_order_relaxed);)
+            {
+            }
+
+            item.m_callback(item);
+            m_executed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+} // namespace ThreadX
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "highResClock.hpp"
+#include "memoryPool.hpp"
+#include "semaphore.hpp"
+#include "thread.hpp"
+#include "txCommon.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace ThreadX
+{
+class WorkQueueBase;
+
+/// Work to run on a WorkQueue thread, embedded in the object it works for. Posting only links the item, so it can be
+/// done from timer callbacks and ISRs. An item that is posted again before it has run, runs once.
+class WorkItem
+{
+  public:
+    using Callback = std::function<void(WorkItem &)>;
+
+    explicit WorkItem(const Callback &callback);
+
+    WorkItem(const WorkItem &) = delete;
+    WorkItem &operator=(const WorkItem &) = delete;
+
+    /// \return true if the item is posted and has not started running
+    bool pending() const;
+
+  private:
+    friend class WorkQueueBase;
+
+    const Callback m_callback;
+    WorkItem *m_next{};
+    std::atomic_bool m_pending{};
+    HighResClock::TimePoint m_postTime{};
+};
+
+/// Counters of a work queue. The latency is from posting to the start of the callback, in microseconds of HighResClock.
+struct WorkQueueMetrics
+{
+    Ulong posted;
+    Ulong coalesced; ///< posts of items that were still pending
+    Ulong executed;
+    Ulong maxLatency;
+};
+
+/// Part of WorkQueue that does not depend on the pool.
+class WorkQueueBase
+{
+  public:
+    WorkQueueBase(const WorkQueueBase &) = delete;
+    WorkQueueBase &operator=(const WorkQueueBase &) = delete;
+
+    /// queues an item without locking. May be called from timer callbacks and ISRs.
+    /// \return false if the item was pending already
+    bool post(WorkItem &item);
+
+    WorkQueueMetrics metrics() const;
+
+    void resetMetrics();
+
+  protected:
+    explicit WorkQueueBase(const std::string_view name);
+    ~WorkQueueBase() = default;
+
+    /// runs the posted items in the order they were posted. It never returns.
+    [[noreturn]] void run();
+
+  private:
+    std::atomic<WorkItem *> m_head{}; // most recently posted item
+    CountingSemaphore<> m_semaphore;  // released when an item is posted to an empty list
+    std::atomic<Ulong> m_posted{};
+    std::atomic<Ulong> m_coalesced{};
+    std::atomic<Ulong> m_executed{};
+    std::atomic<Ulong> m_maxLatency{};
+};
+
+/// Threads that run work handed off by timer callbacks and ISRs, so that their cost does not delay other timers or
+/// interrupts. Use one WorkQueue per priority level.
+/// \tparam Pool pool for the worker stacks
+/// \tparam Workers number of worker threads. With more than one, items of different batches can run concurrently.
+template <class Pool, size_t Workers = 1> class WorkQueue : public WorkQueueBase
+{
+  public:
+    explicit WorkQueue(const std::string_view name, Pool &pool, const Ulong stackSize, const Uint priority = defaultPriority)
+        requires(std::is_base_of_v<BytePoolBase, Pool>);
+
+    explicit WorkQueue(const std::string_view name, Pool &pool, const Uint priority = defaultPriority)
+        requires(std::is_base_of_v<BlockPoolBase, Pool>);
+
+  private:
+    class Worker : public Thread<Pool>
+    {
+      public:
+        template <typename... Args> explicit Worker(WorkQueue &workQueue, Args &&...args);
+
+      private:
+        void entryCallback() final;
+
+        WorkQueue &m_workQueue;
+    };
+
+    std::array<std::optional<Worker>, Workers> m_workers;
+};
+
+template <class Pool, size_t Workers>
+WorkQueue<Pool, Workers>::WorkQueue(const std::string_view name, Pool &pool, const Ulong stackSize, const Uint priority)
+    requires(std::is_base_of_v<BytePoolBase, Pool>)
+    : WorkQueueBase{name}
+{
+    for (auto &worker : m_workers)
+    {
+        worker.emplace(*this, name, pool, stackSize, typename Thread<Pool>::NotifyCallback{}, priority, priority, noTimeSlice, ThreadStartType::dontStart);
+    }
+}
+
+template <class Pool, size_t Workers>
+WorkQueue<Pool, Workers>::WorkQueue(const std::string_view name, Pool &pool, const Uint priority)
+    requires(std::is_base_of_v<BlockPoolBase, Pool>)
+    : WorkQueueBase{name}
+{
+    for (auto &worker : m_workers)
+    {
+        worker.emplace(*this, name, pool, typename Thread<Pool>::NotifyCallback{}, priority, priority, noTimeSlice, ThreadStartType::dontStart);
+    }
+}
+
+template <class Pool, size_t Workers>
+template <typename... Args>
+WorkQueue<Pool, Workers>::Worker::Worker(WorkQueue &workQueue, Args &&...args) : Thread<Pool>{std::forward<Args>(args)...}, m_workQueue{workQueue}
+{
+    // the thread is created suspended so that it cannot run before m_workQueue is set.
+    [[maybe_unused]] auto error{this->resume()};
+    assert(error == Error::success);
+}
+
+template <class Pool, size_t Workers> void WorkQueue<Pool, Workers>::Worker::entryCallback()
+{
+    m_workQueue.run();
+}
+} // namespace ThreadX